@@ -32,6 +32,7 @@ using namespace ace_button;
   AceButton button(BUTTON_PIN);
 #endif
 
+Device closeBySonoffDevice;       //a copy - the Device given to a handler is only valid during the call
 Device *closeBySonoff = NULL;
 
 void onProximateDevice(Device *device, Approximate::DeviceEvent event);
@@ -74,12 +75,13 @@ void onProximateDevice(Device *device, Approximate::DeviceEvent event) {
 void onCloseBySonoff(Device *device, Approximate::DeviceEvent event) {
   switch (event) {
     case Approximate::ARRIVE:
-      closeBySonoff = device;
+      closeBySonoffDevice = Device(device);
+      closeBySonoff = &closeBySonoffDevice;
       digitalWrite(LED_PIN, HIGH);
       Serial.printf("SONOFF\t%s\t(%s)\tARRIVE\n", device -> getMacAddressAsString().c_str(), device -> getIPAddressAsString().c_str());
       break;
     case Approximate::DEPART:
-      if(*device == *closeBySonoff) {
+      if(closeBySonoff && *device == *closeBySonoff) {
         closeBySonoff = NULL;
         digitalWrite(LED_PIN, LOW);
         Serial.printf("SONOFF\t%s\tDEPART\n", device -> getMacAddressAsString().c_str());
@@ -24,12 +24,12 @@ void loop() {
 }
 
 void onChannelStateEvent(Channel *channel) {
-  int8_t a, bi; 
-  for(int n = -26; n <= 26; ++n) {
-    if(n!=0) {
-      channel -> getSubCarrier(n, a, bi);
-      Serial.printf("%i,%i\t", a, bi);
-    }
+  //subcarriers -26 to -1, then 1 to 26:
+  int8_t a[Channel::SUBCARRIERS], bi[Channel::SUBCARRIERS];
+  channel -> getSubCarriers(a, bi);
+
+  for(int i = 0; i < Channel::SUBCARRIERS; ++i) {
+    Serial.printf("%i,%i\t", a[i], bi[i]);
   }
   Serial.printf("\n");
 }
\ No newline at end of file
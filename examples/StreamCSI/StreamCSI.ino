@@ -0,0 +1,35 @@
+/*
+    Stream CSI example for the Approximate Library
+    -
+    Writes channel state information as a binary stream, to be decoded on
+    the host by extras/csidecode, e.g.:
+      stty -F /dev/ttyUSB0 921600 raw && csidecode /dev/ttyUSB0
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include <Approximate.h>
+Approximate approx;
+
+ChannelStreamWriter stream;
+
+void onChannelStateEvent(Channel *channel);
+
+void setup() {
+    //fast enough for several hundred frames a second:
+    Serial.begin(921600);
+
+    if (approx.init("MyHomeWiFi", "password", false, true)) {
+        approx.setChannelStateHandler(onChannelStateEvent);
+        approx.begin();
+    }
+}
+
+void loop() {
+    approx.loop();
+}
+
+void onChannelStateEvent(Channel *channel) {
+  stream.write(channel, Serial);
+}
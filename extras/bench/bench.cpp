@@ -0,0 +1,518 @@
+/*
+    bench.cpp
+    Approximate Library - host benchmarks
+    -
+    Micro-benchmarks of the library's per-frame data structures, run on the
+    host against the stand-ins in extras/native. Absolute times are for this
+    host only - compare the rows with each other, not with an ESP32.
+
+    Usage: bench [name ...]     run only the named benchmarks (default: all)
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include <Approximate.h>
+
+#include <chrono>
+#include <vector>
+
+static uint64_t nowNs() {
+  return(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+//a deterministic stream of random-looking MAC addresses
+static uint64_t nextRandom(uint64_t &state) {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return(state);
+}
+
+static void randomMacAddress(uint64_t &state, eth_addr &out) {
+  uint64_t r = nextRandom(state);
+  for(int n = 0; n < 6; ++n) out.addr[n] = (r >> (n * 8)) & 0xFF;
+  out.addr[0] &= 0xFC;    //individual, universal
+}
+
+static volatile uintptr_t sink = 0;   //keeps lookups from being optimised away
+
+//The proximate device table as it was: a List of Device * scanned in order
+static Device *listLookup(List<Device *> &list, eth_addr &macAddress) {
+  Device *device = NULL;
+
+  for (int n = 0; n < list.Count() && !device; n++) {
+    if(list[n] -> matches(macAddress)) device = list[n];
+  }
+
+  return(device);
+}
+
+static void benchDeviceLookup() {
+  printf("proximate device lookup (ns per lookup)\n");
+  printf("%10s  %12s %12s  %12s %12s\n", "devices", "list hit", "list miss", "table hit", "table miss");
+
+  const int sizes[] = {10, 100, 1000, 5000};
+  for(int size : sizes) {
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+
+    std::vector<eth_addr> present(size), absent(size);
+    for(int n = 0; n < size; ++n) randomMacAddress(state, present[n]);
+    for(int n = 0; n < size; ++n) randomMacAddress(state, absent[n]);
+
+    List<Device *> list;
+    DeviceTable table;
+    table.init(size);
+
+    eth_addr bssid = {{0,0,0,0,0,0}};
+    for(int n = 0; n < size; ++n) {
+      Device device(present[n], bssid, 1, -30);
+      list.Add(new Device(&device));
+      table.add(&device);
+    }
+
+    //enough lookups for each row to take a measurable time
+    const int lookups = max(20000, 4000000 / size);
+    uint64_t t0, listHitNs, listMissNs, tableHitNs, tableMissNs;
+
+    t0 = nowNs();
+    for(int n = 0; n < lookups; ++n) sink += (uintptr_t) listLookup(list, present[(n * 7919) % size]);
+    listHitNs = nowNs() - t0;
+
+    t0 = nowNs();
+    for(int n = 0; n < lookups; ++n) sink += (uintptr_t) listLookup(list, absent[(n * 7919) % size]);
+    listMissNs = nowNs() - t0;
+
+    t0 = nowNs();
+    for(int n = 0; n < lookups; ++n) sink += (uintptr_t) table.get(present[(n * 7919) % size]);
+    tableHitNs = nowNs() - t0;
+
+    t0 = nowNs();
+    for(int n = 0; n < lookups; ++n) sink += (uintptr_t) table.get(absent[(n * 7919) % size]);
+    tableMissNs = nowNs() - t0;
+
+    printf("%10i  %12.1f %12.1f  %12.1f %12.1f\n", size,
+      (double) listHitNs / lookups, (double) listMissNs / lookups, (double) tableHitNs / lookups, (double) tableMissNs / lookups);
+
+    for(int n = 0; n < list.Count(); ++n) delete list[n];
+  }
+  printf("\n");
+}
+
+//The departure sweep as it was: every device checked on every loop(), restarting after each removal
+static int listSweep(List<Device *> &list) {
+  int departed = 0;
+
+  for (int n = 0; n < list.Count(); n++) {
+    Device *device = list[n];
+    if(device -> hasTimedOut()) {
+      list.Remove(n);
+      delete device;
+      ++departed;
+      n = 0;
+    }
+  }
+
+  return(departed);
+}
+
+static int tableSweep(DeviceTable &table) {
+  int departed = 0;
+
+  DeviceRecord *record = NULL;
+  while((record = table.getTimedOut()) != NULL) {
+    table.remove(record);
+    ++departed;
+  }
+
+  return(departed);
+}
+
+static void benchDepartures() {
+  printf("departure sweep in loop() (us per call)\n");
+  printf("%10s  %12s %12s  %12s %12s\n", "devices", "list idle", "list all go", "table idle", "table all go");
+
+  const int sizes[] = {10, 100, 1000, 5000};
+  for(int size : sizes) {
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    eth_addr bssid = {{0,0,0,0,0,0}};
+
+    nativeSetMillis(1000);
+
+    List<Device *> list;
+    DeviceTable table;
+    table.init(size);
+
+    //every device times out at the same moment - the end of a meeting
+    for(int n = 0; n < size; ++n) {
+      eth_addr macAddress;
+      randomMacAddress(state, macAddress);
+
+      Device device(macAddress, bssid, 1, -30);
+      Device *listDevice = new Device(&device);
+      listDevice -> setTimeOutAtMs(61000);
+      list.Add(listDevice);
+      table.setTimeOutAtMs(table.add(&device), 61000);
+    }
+
+    //idle - loop() runs every 10ms and nothing has timed out yet
+    const int idleCalls = 1000;
+    uint64_t t0, listIdleNs = 0, tableIdleNs = 0;
+    for(int n = 0; n < idleCalls; ++n) {
+      nativeSetMillis(1000 + n * 10);
+      t0 = nowNs();
+      sink += listSweep(list);
+      listIdleNs += nowNs() - t0;
+      t0 = nowNs();
+      sink += tableSweep(table);
+      tableIdleNs += nowNs() - t0;
+    }
+
+    nativeSetMillis(61001);
+    t0 = nowNs();
+    int listDeparted = listSweep(list);
+    uint64_t listGoNs = nowNs() - t0;
+    t0 = nowNs();
+    int tableDeparted = tableSweep(table);
+    uint64_t tableGoNs = nowNs() - t0;
+
+    //the old sweep restarts at index 1 after a removal, so one device is always left behind
+    if(listDeparted != size - 1 || tableDeparted != size) printf("error: %i and %i of %i departed\n", listDeparted, tableDeparted, size);
+
+    printf("%10i  %12.2f %12.1f  %12.2f %12.1f\n", size,
+      listIdleNs / 1e3 / idleCalls, listGoNs / 1e3, tableIdleNs / 1e3 / idleCalls, tableGoNs / 1e3);
+  }
+
+  //the same meeting as millis() wraps, half a minute in - each device should depart within a tick of its time out
+  const int size = 1000;
+  const uint32_t startMs = 0xFFFFFFFFUL - 30000;
+  uint64_t state = 0x2545F4914F6CDD1DULL;
+  eth_addr bssid = {{0,0,0,0,0,0}};
+
+  nativeSetMillis(startMs);
+
+  DeviceTable table;
+  table.init(size);
+  std::vector<uint32_t> timeOutAtMs(size);   //by slot
+  for(int n = 0; n < size; ++n) {
+    eth_addr macAddress;
+    randomMacAddress(state, macAddress);
+
+    Device device(macAddress, bssid, 1, -30);
+    DeviceRecord *record = table.add(&device);
+    timeOutAtMs[table.getSlot(record)] = startMs + 1000 + (nextRandom(state) % 60000);
+    table.setTimeOutAtMs(record, timeOutAtMs[table.getSlot(record)]);
+  }
+
+  int departed = 0, early = 0;
+  uint32_t lateMs = 0;
+  for(uint32_t elapsedMs = 0; elapsedMs <= 70000; elapsedMs += 10) {
+    uint32_t nowMs = startMs + elapsedMs;
+    nativeSetMillis(nowMs);
+
+    DeviceRecord *record = NULL;
+    while((record = table.getTimedOut()) != NULL) {
+      int32_t overMs = (int32_t) (nowMs - timeOutAtMs[table.getSlot(record)]);
+      if(overMs < 0) ++early;
+      else lateMs = max(lateMs, (uint32_t) overMs);
+
+      table.remove(record);
+      ++departed;
+    }
+  }
+
+  printf("across the millis() wrap: %i of %i departed, none more than %u ms late\n", departed, size, (unsigned) lateMs);
+  if(departed != size || early > 0 || lateMs > (1 << APPROXIMATE_TIMER_WHEEL_TICK_SHIFT)) printf("error: %i departed, %i early, up to %u ms late\n", departed, early, (unsigned) lateMs);
+  printf("\n");
+}
+
+//The active device filters as they were: each Filter in the list tried in turn
+static bool listMatches(List<Filter *> &filters, Device *device) {
+  bool result = false;
+
+  for (int n = 0; n < filters.Count() && !result; n++) result = filters[n] -> matches(device);
+
+  return(result);
+}
+
+static void benchFilters() {
+  printf("active device filters (ns per device, with a quarter of the filters OUIs)\n");
+  printf("%10s  %12s %12s  %12s %12s  %10s\n", "filters", "list hit", "list miss", "set hit", "set miss", "mismatches");
+
+  const int sizes[] = {10, 100, 300, 1000};
+  const Filter::Direction directions[] = {Filter::EITHER, Filter::SENDS, Filter::RECEIVES, Filter::NEITHER};
+
+  for(int size : sizes) {
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    eth_addr bssid = {{0,0,0,0,0,0}};
+
+    List<Filter *> filters;
+    std::vector<Device> present, absent;
+
+    for(int n = 0; n < size; ++n) {
+      eth_addr macAddress;
+      randomMacAddress(state, macAddress);
+      if(n % 4 == 3) macAddress.addr[3] = macAddress.addr[4] = macAddress.addr[5] = 0xFF;
+
+      filters.Add(new Filter(macAddress, directions[nextRandom(state) % 4]));
+
+      //a device matching this filter's address, with a random data flow:
+      if(n % 4 == 3) macAddress.addr[5] = nextRandom(state) & 0xFF;
+      present.push_back(Device(macAddress, bssid, 1, -30, 0, (int) (nextRandom(state) % 3) - 1));
+
+      randomMacAddress(state, macAddress);
+      absent.push_back(Device(macAddress, bssid, 1, -30, 0, -100));
+    }
+
+    //the special addresses - ANY matches every filter, NONE none of them
+    present.push_back(Device(Filter::ANY, bssid, 1, -30, 0, -100));
+    absent.push_back(Device(Filter::NONE, bssid, 1, -30, 0, -100));
+
+    FilterSet filterSet;
+    filterSet.compile(filters);
+
+    int mismatches = 0;
+    for(Device &device : present) mismatches += (listMatches(filters, &device) != filterSet.matches(&device));
+    for(Device &device : absent)  mismatches += (listMatches(filters, &device) != filterSet.matches(&device));
+
+    const int lookups = max(20000, 2000000 / size);
+    uint64_t t0, listHitNs, listMissNs, setHitNs, setMissNs;
+
+    t0 = nowNs();
+    for(int n = 0; n < lookups; ++n) sink += listMatches(filters, &present[(n * 7919) % present.size()]);
+    listHitNs = nowNs() - t0;
+
+    t0 = nowNs();
+    for(int n = 0; n < lookups; ++n) sink += listMatches(filters, &absent[(n * 7919) % absent.size()]);
+    listMissNs = nowNs() - t0;
+
+    t0 = nowNs();
+    for(int n = 0; n < lookups; ++n) sink += filterSet.matches(&present[(n * 7919) % present.size()]);
+    setHitNs = nowNs() - t0;
+
+    t0 = nowNs();
+    for(int n = 0; n < lookups; ++n) sink += filterSet.matches(&absent[(n * 7919) % absent.size()]);
+    setMissNs = nowNs() - t0;
+
+    printf("%10i  %12.1f %12.1f  %12.1f %12.1f  %10i\n", size,
+      (double) listHitNs / lookups, (double) listMissNs / lookups, (double) setHitNs / lookups, (double) setMissNs / lookups, mismatches);
+
+    for(int n = 0; n < filters.Count(); ++n) delete filters[n];
+  }
+  printf("\n");
+}
+
+static void benchChannelState() {
+  printf("channel state information (ns per channel of %i subcarriers)\n", Channel::SUBCARRIERS);
+  printf("%12s %12s %12s  %14s %14s\n", "per carrier", "bulk float", "bulk fixed", "magnitude err", "phase err (mrad)");
+
+  //every possible subcarrier value, across enough channels to hold them all
+  const int channelCount = (256 * 256) / Channel::SUBCARRIERS + 1;
+  std::vector<Channel> channels(channelCount);
+  for(int c = 0, v = 0; c < channelCount; ++c) {
+    int8_t buf[128] = {0};
+    for(int i = 0; i < Channel::SUBCARRIERS; ++i, ++v) {
+      int n = Channel::getSubCarrierNumber(i);
+      int index = (n > 0) ? (n * 2) + 2 : (128 - 2) + (n * 2) + 2;
+      buf[index] = (int8_t) (v & 0xFF);
+      buf[index + 1] = (int8_t) ((v >> 8) & 0xFF);
+    }
+    channels[c].setBuffer(buf);
+  }
+
+  //the fixed-point path against the float
+  float magnitudeError = 0, phaseError = 0;
+  for(Channel &channel : channels) {
+    float magnitude[Channel::SUBCARRIERS], phase[Channel::SUBCARRIERS];
+    uint16_t fixedMagnitude[Channel::SUBCARRIERS];
+    int16_t fixedPhase[Channel::SUBCARRIERS];
+    channel.getSubCarriers(magnitude, phase);
+    channel.getSubCarriers(fixedMagnitude, fixedPhase);
+
+    for(int i = 0; i < Channel::SUBCARRIERS; ++i) {
+      if(magnitude[i] > 0) magnitudeError = max(magnitudeError, fabsf(((float) fixedMagnitude[i] / Channel::MAGNITUDE_SCALE) - magnitude[i]) / magnitude[i]);
+      phaseError = max(phaseError, fabsf(((float) fixedPhase[i] / Channel::PHASE_SCALE) - phase[i]) * 1000);
+    }
+  }
+
+  const int rounds = 20;
+  uint64_t t0, perCarrierNs, bulkFloatNs, bulkFixedNs;
+  float sum = 0;
+
+  //as MonitorCSI did: each subcarrier asked for in turn
+  t0 = nowNs();
+  for(int r = 0; r < rounds; ++r) {
+    for(Channel &channel : channels) {
+      for(int n = -26; n <= 26; ++n) {
+        if(n != 0) {
+          float magnitude, phase;
+          channel.getSubCarrier(n, magnitude, phase);
+          sum += magnitude + phase;
+        }
+      }
+    }
+  }
+  perCarrierNs = nowNs() - t0;
+
+  t0 = nowNs();
+  for(int r = 0; r < rounds; ++r) {
+    for(Channel &channel : channels) {
+      float magnitude[Channel::SUBCARRIERS], phase[Channel::SUBCARRIERS];
+      channel.getSubCarriers(magnitude, phase);
+      sum += magnitude[r] + phase[r];
+    }
+  }
+  bulkFloatNs = nowNs() - t0;
+
+  t0 = nowNs();
+  for(int r = 0; r < rounds; ++r) {
+    for(Channel &channel : channels) {
+      uint16_t magnitude[Channel::SUBCARRIERS];
+      int16_t phase[Channel::SUBCARRIERS];
+      channel.getSubCarriers(magnitude, phase);
+      sink += magnitude[r] + phase[r];
+    }
+  }
+  bulkFixedNs = nowNs() - t0;
+  sink += (uintptr_t) sum;
+
+  const int calls = rounds * channelCount;
+  printf("%12.1f %12.1f %12.1f  %13.2f%% %14.2f\n\n",
+    (double) perCarrierNs / calls, (double) bulkFloatNs / calls, (double) bulkFixedNs / calls, magnitudeError * 100, phaseError);
+}
+
+//The MAC address codec as it was: sscanf and sprintf
+static bool legacyParse(const char *in, eth_addr &out) {
+  bool success = false;
+
+  for(int n=0; n<6; ++n) out.addr[n] = 0;
+
+  if(strlen(in) == 17) {
+    int a, b, c, d, e, f;
+    sscanf(in, "%x:%x:%x:%x:%x:%x", &a, &b, &c, &d, &e, &f);
+
+    out.addr[0] = a;
+    out.addr[1] = b;
+    out.addr[2] = c;
+    out.addr[3] = d;
+    out.addr[4] = e;
+    out.addr[5] = f;
+
+    success = true;
+  }
+
+  return(success);
+}
+
+static void legacyFormat(eth_addr &in, char *out) {
+  sprintf(out, "%02X:%02X:%02X:%02X:%02X:%02X", in.addr[0], in.addr[1], in.addr[2], in.addr[3], in.addr[4], in.addr[5]);
+}
+
+static void benchMacAddressCodec() {
+  printf("MAC address codec (ns per address)\n");
+  printf("%12s %12s %12s %12s %12s  %10s %10s\n", "sprintf", "table format", "to String", "sscanf", "table parse", "mismatches", "rejected");
+
+  const int count = 100000;
+  uint64_t state = 0x2545F4914F6CDD1DULL;
+  std::vector<eth_addr> addresses(count);
+  std::vector<char> text(count * 18);
+  for(int n = 0; n < count; ++n) {
+    randomMacAddress(state, addresses[n]);
+    legacyFormat(addresses[n], &text[n * 18]);
+    if(n & 1) for(char *c = &text[n * 18]; *c; ++c) *c = tolower(*c);
+  }
+
+  //the two must agree - on formatting, and on parsing what was formatted
+  int mismatches = 0;
+  for(int n = 0; n < count; ++n) {
+    char out[18];
+    eth_addr parsed;
+    eth_addr_to_c_str(addresses[n], out);
+    if(strcasecmp(out, &text[n * 18]) != 0) ++mismatches;
+    if(!c_str_to_eth_addr(&text[n * 18], parsed) || !eth_addr_cmp(&parsed, &addresses[n])) ++mismatches;
+  }
+
+  //and malformed addresses - which sscanf would have half-read - are refused
+  const char *malformed[] = { "00:11:22:33:44:5G", "00:11:22:33:44-55", "00:11:22:33:44:5", "0011223344556", "00:11:22:33:44:55:", "", "00 11 22 33 44 55", "\xC0\xB0:11:22:33:44:55" };
+  const char *wellFormed[] = { "00-11-22-33-44-55", "001122334455", "aA:bB:cC:dD:eE:fF" };
+  int rejected = 0;
+  for(const char *in : malformed) {
+    eth_addr parsed;
+    if(!c_str_to_eth_addr(in, parsed)) ++rejected;
+  }
+  for(const char *in : wellFormed) {
+    eth_addr parsed;
+    if(!c_str_to_eth_addr(in, parsed)) ++mismatches;
+  }
+
+  uint64_t t0, sprintfNs, tableFormatNs, stringNs, sscanfNs, tableParseNs;
+  char out[18];
+
+  t0 = nowNs();
+  for(int n = 0; n < count; ++n) {
+    legacyFormat(addresses[n], out);
+    sink += out[n % 17];
+  }
+  sprintfNs = nowNs() - t0;
+
+  t0 = nowNs();
+  for(int n = 0; n < count; ++n) {
+    eth_addr_to_c_str(addresses[n], out);
+    sink += out[n % 17];
+  }
+  tableFormatNs = nowNs() - t0;
+
+  t0 = nowNs();
+  String macAddress;
+  for(int n = 0; n < count; ++n) {
+    eth_addr_to_String(addresses[n], macAddress);
+    sink += macAddress.length();
+  }
+  stringNs = nowNs() - t0;
+
+  t0 = nowNs();
+  for(int n = 0; n < count; ++n) {
+    eth_addr parsed;
+    legacyParse(&text[n * 18], parsed);
+    sink += parsed.addr[5];
+  }
+  sscanfNs = nowNs() - t0;
+
+  t0 = nowNs();
+  for(int n = 0; n < count; ++n) {
+    eth_addr parsed;
+    c_str_to_eth_addr(&text[n * 18], parsed);
+    sink += parsed.addr[5];
+  }
+  tableParseNs = nowNs() - t0;
+
+  printf("%12.1f %12.1f %12.1f %12.1f %12.1f  %10i %7i/%zu\n\n",
+    (double) sprintfNs / count, (double) tableFormatNs / count, (double) stringNs / count, (double) sscanfNs / count, (double) tableParseNs / count,
+    mismatches, rejected, sizeof(malformed) / sizeof(malformed[0]));
+}
+
+typedef struct {
+  const char *name;
+  void (*run)();
+} Benchmark;
+
+static const Benchmark benchmarks[] = {
+  {"devices", benchDeviceLookup},
+  {"departures", benchDepartures},
+  {"filters", benchFilters},
+  {"csi", benchChannelState},
+  {"mac", benchMacAddressCodec},
+};
+
+int main(int argc, char **argv) {
+  Serial.quiet = true;
+
+  for(const Benchmark &benchmark : benchmarks) {
+    bool selected = (argc < 2);
+    for(int n = 1; n < argc && !selected; ++n) selected = (strcmp(argv[n], benchmark.name) == 0);
+
+    if(selected) benchmark.run();
+  }
+
+  return(0);
+}
@@ -0,0 +1,100 @@
+/*
+    csidecode.cpp
+    Approximate Library - channel state information stream decoder
+    -
+    Decodes the binary CSI stream written by ChannelStreamWriter (see the
+    StreamCSI example) from a file, a serial port or stdin, and prints each
+    frame as a line of CSV: its sequence number, timestamp, source, RSSI and
+    channel, then the 52 subcarriers from -26 to 26. Anything else written to
+    the same port is skipped. A summary of the frames read, corrupt and
+    dropped is written to stderr at the end.
+
+    Usage: csidecode [options] [stream]     (default: stdin)
+      --polar       subcarriers as magnitude,phase (radians) rather than a,bi
+      --no-header   omit the CSV header line
+      --quiet       print only the summary
+
+    e.g. from an ESP32 on a serial port:
+      stty -F /dev/ttyUSB0 921600 raw && csidecode /dev/ttyUSB0
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include <Approximate.h>
+
+static void usage() {
+  fprintf(stderr, "usage: csidecode [--polar] [--no-header] [--quiet] [stream]\n");
+}
+
+static void printHeader(bool polar) {
+  printf("sequence,timestamp_us,source,rssi,channel");
+  for(int i = 0; i < Channel::SUBCARRIERS; ++i) {
+    int n = Channel::getSubCarrierNumber(i);
+    if(polar) printf(",magnitude%i,phase%i", n, n);
+    else printf(",a%i,bi%i", n, n);
+  }
+  printf("\n");
+}
+
+static void printFrame(ChannelStreamReader &reader, Channel &channel, bool polar) {
+  char source[18];
+  printf("%u,%lu,%s,%i,%i", reader.getSequence(), (unsigned long) channel.getTimestampUs(), channel.getBssidAs_c_str(source), channel.getRSSI(), channel.getChannel());
+
+  if(polar) {
+    float magnitude[Channel::SUBCARRIERS], phase[Channel::SUBCARRIERS];
+    channel.getSubCarriers(magnitude, phase);
+    for(int i = 0; i < Channel::SUBCARRIERS; ++i) printf(",%.2f,%.4f", magnitude[i], phase[i]);
+  }
+  else {
+    int8_t a[Channel::SUBCARRIERS], bi[Channel::SUBCARRIERS];
+    channel.getSubCarriers(a, bi);
+    for(int i = 0; i < Channel::SUBCARRIERS; ++i) printf(",%i,%i", a[i], bi[i]);
+  }
+  printf("\n");
+}
+
+int main(int argc, char **argv) {
+  const char *path = NULL;
+  bool polar = false;
+  bool header = true;
+  bool quiet = false;
+
+  for(int n = 1; n < argc; ++n) {
+    String arg = argv[n];
+
+    if(arg == "--polar")                  polar = true;
+    else if(arg == "--no-header")         header = false;
+    else if(arg == "--quiet")             quiet = true;
+    else if(argv[n][0] != '-' && !path)   path = argv[n];
+    else {
+      usage();
+      return(2);
+    }
+  }
+
+  FILE *in = path ? fopen(path, "rb") : stdin;
+  if(!in) {
+    fprintf(stderr, "csidecode: cannot read %s\n", path);
+    return(1);
+  }
+
+  if(header && !quiet) printHeader(polar);
+
+  ChannelStreamReader reader;
+  Channel channel;
+  uint8_t buffer[4096];
+  size_t length;
+  while((length = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+    for(size_t n = 0; n < length; ++n) {
+      if(reader.read(buffer[n], channel) && !quiet) printFrame(reader, channel, polar);
+    }
+    if(!quiet) fflush(stdout);
+  }
+  if(path) fclose(in);
+
+  fprintf(stderr, "csidecode: %lu frames, %lu corrupt, %lu dropped, %lu bytes skipped\n",
+    reader.getFrameCount(), reader.getCorruptCount(), reader.getDroppedCount(), reader.getSkippedBytes());
+
+  return(0);
+}
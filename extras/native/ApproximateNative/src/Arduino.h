@@ -0,0 +1,144 @@
+/*
+    Arduino.h
+    Approximate Library - native build
+    -
+    Host stand-in for the parts of the Arduino core used by Approximate. Time is
+    virtual: millis() only moves when the host program calls nativeSetMillis().
+    As on the ESP8266 and ESP32, millis() is a 32-bit count that wraps after
+    49.7 days, even where unsigned long is 64 bits wide.
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+
+#include <algorithm>
+#include <string>
+
+using std::min;
+using std::max;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT  0x0
+#define OUTPUT 0x1
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void yield();
+
+void nativeSetMillis(unsigned long ms);
+
+inline void pinMode(uint8_t pin, uint8_t mode) {}
+inline void digitalWrite(uint8_t pin, uint8_t val) {}
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+class String {
+  private:
+    std::string buffer;
+
+  public:
+    String() {}
+    String(const char *cstr) : buffer(cstr ? cstr : "") {}
+    String(const std::string &s) : buffer(s) {}
+    String(char c) : buffer(1, c) {}
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+
+    const char *c_str() const { return buffer.c_str(); }
+    unsigned int length() const { return buffer.length(); }
+    bool reserve(unsigned int size) { buffer.reserve(size); return true; }
+
+    bool concat(const String &s) { buffer += s.buffer; return true; }
+    bool concat(const char *cstr) { if(cstr) buffer += cstr; return true; }
+    bool concat(char c) { buffer += c; return true; }
+
+    String &operator +=(const String &rhs) { concat(rhs); return *this; }
+    String &operator +=(const char *cstr) { concat(cstr); return *this; }
+    String &operator +=(char c) { concat(c); return *this; }
+
+    bool operator ==(const String &rhs) const { return buffer == rhs.buffer; }
+    bool operator ==(const char *cstr) const { return buffer == (cstr ? cstr : ""); }
+    bool operator !=(const String &rhs) const { return !(*this == rhs); }
+    bool operator !=(const char *cstr) const { return !(*this == cstr); }
+    char operator [](unsigned int index) const { return index < buffer.length() ? buffer[index] : 0; }
+
+    bool equals(const String &s) const { return *this == s; }
+    long toInt() const { return atol(buffer.c_str()); }
+
+    friend String operator +(const String &lhs, const String &rhs);
+    friend String operator +(const String &lhs, const char *rhs);
+    friend String operator +(const char *lhs, const String &rhs);
+};
+
+String operator +(const String &lhs, const String &rhs);
+String operator +(const String &lhs, const char *rhs);
+String operator +(const char *lhs, const String &rhs);
+
+class Print {
+  public:
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+
+    size_t print(const char *cstr);
+    size_t print(const String &s);
+    size_t print(char c);
+    size_t print(int value);
+    size_t print(long value);
+    size_t print(unsigned long value);
+    size_t print(double value, int digits = 2);
+
+    size_t println();
+    size_t println(const char *cstr);
+    size_t println(const String &s);
+    size_t println(int value);
+    size_t println(long value);
+    size_t println(unsigned long value);
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+// Serial writes to stderr so that host programs keep stdout for their own reports.
+class HardwareSerial : public Print {
+  public:
+    bool quiet = false;
+
+    void begin(unsigned long baud) {}
+    void flush() { fflush(stderr); }
+
+    using Print::write;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+};
+
+extern HardwareSerial Serial;
+
+// The cycle counter runs at a nominal 1GHz - it counts the host's real nanoseconds, not virtual time.
+class EspClass {
+  public:
+    uint32_t getCycleCount();
+    uint32_t getCpuFreqMHz() { return 1000; }
+};
+
+extern EspClass ESP;
+
+#endif
@@ -0,0 +1,251 @@
+/*
+    Native.cpp
+    Approximate Library - native build
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include "lwip/etharp.h"
+
+#include <time.h>
+
+// ---- Time ----
+
+static unsigned long nativeMillis = 0;
+
+unsigned long millis() {
+  return((uint32_t) nativeMillis);
+}
+
+unsigned long micros() {
+  return((uint32_t) (nativeMillis * 1000));
+}
+
+void delay(unsigned long ms) {
+  nativeMillis += ms;
+}
+
+void yield() {
+}
+
+void nativeSetMillis(unsigned long ms) {
+  nativeMillis = ms;
+}
+
+// ---- String ----
+
+static std::string toString(unsigned long value, bool negative, unsigned char base) {
+  char buf[8 * sizeof(unsigned long) + 2];
+  char *p = &buf[sizeof(buf) - 1];
+  *p = '\0';
+
+  if(base < 2) base = 10;
+  do {
+    unsigned long digit = value % base;
+    *--p = (char) (digit < 10 ? '0' + digit : 'A' + digit - 10);
+    value /= base;
+  } while(value);
+
+  if(negative) *--p = '-';
+
+  return(std::string(p));
+}
+
+String::String(int value, unsigned char base) : buffer(toString(value < 0 && base == 10 ? -(long) value : (unsigned int) value, value < 0 && base == 10, base)) {}
+String::String(unsigned int value, unsigned char base) : buffer(toString(value, false, base)) {}
+String::String(long value, unsigned char base) : buffer(toString(value < 0 && base == 10 ? -value : value, value < 0 && base == 10, base)) {}
+String::String(unsigned long value, unsigned char base) : buffer(toString(value, false, base)) {}
+
+String operator +(const String &lhs, const String &rhs) {
+  return(String(lhs.buffer + rhs.buffer));
+}
+
+String operator +(const String &lhs, const char *rhs) {
+  return(String(lhs.buffer + (rhs ? rhs : "")));
+}
+
+String operator +(const char *lhs, const String &rhs) {
+  return(String((lhs ? lhs : "") + rhs.buffer));
+}
+
+// ---- Print / Serial ----
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
+  while(size--) n += write(*buffer++);
+  return(n);
+}
+
+size_t Print::print(const char *cstr)       { return(write((const uint8_t *) cstr, strlen(cstr))); }
+size_t Print::print(const String &s)        { return(print(s.c_str())); }
+size_t Print::print(char c)                 { return(write((uint8_t) c)); }
+size_t Print::print(int value)              { return(printf("%d", value)); }
+size_t Print::print(long value)             { return(printf("%ld", value)); }
+size_t Print::print(unsigned long value)    { return(printf("%lu", value)); }
+size_t Print::print(double value, int digits) { return(printf("%.*f", digits, value)); }
+
+size_t Print::println()                     { return(print("\r\n")); }
+size_t Print::println(const char *cstr)     { return(print(cstr) + println()); }
+size_t Print::println(const String &s)      { return(print(s) + println()); }
+size_t Print::println(int value)            { return(print(value) + println()); }
+size_t Print::println(long value)           { return(print(value) + println()); }
+size_t Print::println(unsigned long value)  { return(print(value) + println()); }
+
+size_t Print::printf(const char *format, ...) {
+  char buf[256];
+
+  va_list args;
+  va_start(args, format);
+  int len = vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+
+  if(len < 0) return(0);
+  return(write((const uint8_t *) buf, min((size_t) len, sizeof(buf) - 1)));
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  if(!quiet) fputc(c, stderr);
+  return(1);
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+  if(!quiet) fwrite(buffer, 1, size, stderr);
+  return(size);
+}
+
+HardwareSerial Serial;
+
+// ---- ESP ----
+
+uint32_t EspClass::getCycleCount() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return((uint32_t) ((uint64_t) now.tv_sec * 1000000000ULL + now.tv_nsec));
+}
+
+EspClass ESP;
+
+// ---- WiFi ----
+
+String IPAddress::toString() const {
+  char buf[16];
+  snprintf(buf, sizeof(buf), "%u.%u.%u.%u", octets[0], octets[1], octets[2], octets[3]);
+  return(String(buf));
+}
+
+String WiFiClass::macAddress() {
+  char buf[18];
+  snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X", stationMacAddress[0], stationMacAddress[1], stationMacAddress[2], stationMacAddress[3], stationMacAddress[4], stationMacAddress[5]);
+  return(String(buf));
+}
+
+void WiFiClass::nativeSetLocalIP(IPAddress ip, IPAddress mask) {
+  for(int n = 0; n < 4; ++n) {
+    localAddress[n] = ip[n];
+    netmask[n] = mask[n];
+  }
+
+  netif_default -> ip_addr.addr = (uint32_t) ip;
+  netif_default -> netmask.addr = (uint32_t) mask;
+}
+
+WiFiClass WiFi;
+
+// ---- lwIP ARP ----
+
+static struct netif nativeNetif = {{PP_HTONL(LWIP_MAKEU32(192, 168, 1, 2))}, {PP_HTONL(LWIP_MAKEU32(255, 255, 255, 0))}};
+struct netif *netif_default = &nativeNetif;
+
+typedef struct {
+  ip4_addr_t ipaddr;
+  struct eth_addr macAddress;
+} NativeArpHost;
+
+static NativeArpHost *arpHosts = NULL;
+static size_t arpHostCount = 0;
+static size_t arpHostCapacity = 0;
+
+static struct {
+  bool valid;
+  ip4_addr_t ipaddr;
+  struct eth_addr macAddress;
+} arpTable[ARP_TABLE_SIZE];
+static size_t arpTableNext = 0;
+static unsigned long arpRequestCount = 0;
+
+char *ip4addr_ntoa(const ip4_addr_t *addr) {
+  static char buf[16];
+  const u8_t *bytes = (const u8_t *) &(addr -> addr);
+  snprintf(buf, sizeof(buf), "%u.%u.%u.%u", bytes[0], bytes[1], bytes[2], bytes[3]);
+  return(buf);
+}
+
+ssize_t etharp_find_addr(struct netif *netif, const ip4_addr_t *ipaddr, struct eth_addr **eth_ret, const ip4_addr_t **ip_ret) {
+  for(size_t n = 0; n < ARP_TABLE_SIZE; ++n) {
+    if(arpTable[n].valid && arpTable[n].ipaddr.addr == ipaddr -> addr) {
+      *eth_ret = &arpTable[n].macAddress;
+      *ip_ret = &arpTable[n].ipaddr;
+      return((ssize_t) n);
+    }
+  }
+
+  return(-1);
+}
+
+int etharp_get_entry(size_t i, ip4_addr_t **ipaddr, struct netif **netif, struct eth_addr **eth_ret) {
+  if(i < ARP_TABLE_SIZE && arpTable[i].valid) {
+    *ipaddr = &arpTable[i].ipaddr;
+    *netif = netif_default;
+    *eth_ret = &arpTable[i].macAddress;
+    return(1);
+  }
+
+  return(0);
+}
+
+err_t etharp_request(struct netif *netif, const ip4_addr_t *ipaddr) {
+  ++arpRequestCount;
+
+  for(size_t n = 0; n < arpHostCount; ++n) {
+    if(arpHosts[n].ipaddr.addr == ipaddr -> addr) {
+      //the host replies - it replaces the oldest entry, as lwIP does once the table is full
+      struct eth_addr *eth_ret;
+      const ip4_addr_t *ip_ret;
+      ssize_t i = etharp_find_addr(netif, ipaddr, &eth_ret, &ip_ret);
+      if(i < 0) {
+        i = arpTableNext;
+        arpTableNext = (arpTableNext + 1) % ARP_TABLE_SIZE;
+      }
+
+      arpTable[i].valid = true;
+      arpTable[i].ipaddr = arpHosts[n].ipaddr;
+      arpTable[i].macAddress = arpHosts[n].macAddress;
+      break;
+    }
+  }
+
+  return(ERR_OK);
+}
+
+void nativeAddArpHost(ip4_addr_t &ipaddr, struct eth_addr &macAddress) {
+  if(arpHostCount == arpHostCapacity) {
+    arpHostCapacity = arpHostCapacity ? arpHostCapacity * 2 : 16;
+    arpHosts = (NativeArpHost *) realloc(arpHosts, arpHostCapacity * sizeof(NativeArpHost));
+  }
+
+  arpHosts[arpHostCount].ipaddr = ipaddr;
+  arpHosts[arpHostCount].macAddress = macAddress;
+  ++arpHostCount;
+}
+
+void nativeClearArpTable() {
+  for(size_t n = 0; n < ARP_TABLE_SIZE; ++n) arpTable[n].valid = false;
+  arpTableNext = 0;
+}
+
+unsigned long nativeGetArpRequestCount() {
+  return(arpRequestCount);
+}
@@ -0,0 +1,93 @@
+/*
+    WiFi.h
+    Approximate Library - native build
+    -
+    Host stand-in for the Arduino WiFi class. Reports whatever connection state
+    the host program has configured, and is always connected unless told otherwise.
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#ifndef WiFi_h
+#define WiFi_h
+
+#include <Arduino.h>
+#include "lwip/etharp.h"
+
+typedef enum {
+  WL_NO_SHIELD        = 255,
+  WL_IDLE_STATUS      = 0,
+  WL_NO_SSID_AVAIL    = 1,
+  WL_SCAN_COMPLETED   = 2,
+  WL_CONNECTED        = 3,
+  WL_CONNECT_FAILED   = 4,
+  WL_CONNECTION_LOST  = 5,
+  WL_DISCONNECTED     = 6
+} wl_status_t;
+
+typedef enum {
+  WIFI_OFF    = 0,
+  WIFI_STA    = 1,
+  WIFI_AP     = 2,
+  WIFI_AP_STA = 3
+} WiFiMode_t;
+
+class IPAddress {
+  private:
+    uint8_t octets[4] = {0, 0, 0, 0};
+
+  public:
+    IPAddress() {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : octets{a, b, c, d} {}
+    IPAddress(uint32_t address) { memcpy(octets, &address, 4); }
+
+    operator uint32_t() const { uint32_t address; memcpy(&address, octets, 4); return address; }
+    uint8_t operator [](int index) const { return octets[index]; }
+    uint8_t &operator [](int index) { return octets[index]; }
+
+    String toString() const;
+};
+
+class WiFiClass {
+  private:
+    wl_status_t currentStatus = WL_CONNECTED;
+    uint8_t stationMacAddress[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+    uint8_t bssid[6] = {0, 0, 0, 0, 0, 0};
+    int currentChannel = 1;
+    uint8_t localAddress[4] = {192, 168, 1, 2};
+    uint8_t netmask[4] = {255, 255, 255, 0};
+
+  public:
+    wl_status_t status() { return currentStatus; }
+    wl_status_t begin(const char *ssid, const char *passphrase = NULL) { return currentStatus; }
+    bool disconnect(bool wifiOff = false) { return true; }
+    void persistent(bool persistent) {}
+    bool mode(WiFiMode_t mode) { return true; }
+
+    uint8_t *macAddress(uint8_t *mac) { memcpy(mac, stationMacAddress, 6); return mac; }
+    String macAddress();
+
+    int8_t scanNetworks() { return 1; }
+    String SSID(uint8_t networkItem) { return SSID(); }
+    String SSID() { return String("native"); }
+    String psk() { return String(""); }
+    uint8_t encryptionType(uint8_t networkItem) { return 0x7; }
+    uint8_t *BSSID(uint8_t networkItem) { return bssid; }
+    uint8_t *BSSID() { return bssid; }
+    int32_t channel(uint8_t networkItem) { return currentChannel; }
+    int32_t channel() { return currentChannel; }
+
+    IPAddress localIP() { return IPAddress(localAddress[0], localAddress[1], localAddress[2], localAddress[3]); }
+    IPAddress subnetMask() { return IPAddress(netmask[0], netmask[1], netmask[2], netmask[3]); }
+
+    // Host-side configuration:
+    void nativeSetStatus(wl_status_t status) { currentStatus = status; }
+    void nativeSetBSSID(const uint8_t *bssid) { memcpy(this -> bssid, bssid, 6); }
+    void nativeSetChannel(int channel) { currentChannel = channel; }
+    void nativeSetLocalIP(IPAddress ip, IPAddress mask);
+};
+
+extern WiFiClass WiFi;
+
+#endif
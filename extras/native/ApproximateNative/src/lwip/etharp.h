@@ -0,0 +1,73 @@
+/*
+    lwip/etharp.h
+    Approximate Library - native build
+    -
+    Host stand-in for the lwIP types and ARP calls used by Approximate. The ARP
+    table holds ARP_TABLE_SIZE entries, like lwIP; etharp_request() only fills an
+    entry for hosts that have been added with nativeAddArpHost().
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#ifndef lwip_etharp_h
+#define lwip_etharp_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/types.h>
+
+typedef uint8_t   u8_t;
+typedef int8_t    s8_t;
+typedef uint16_t  u16_t;
+typedef int16_t   s16_t;
+typedef uint32_t  u32_t;
+typedef int32_t   s32_t;
+typedef s8_t      err_t;
+
+#define ERR_OK    0
+
+#define ETHARP_HWADDR_LEN 6
+#define ARP_TABLE_SIZE    10
+
+struct eth_addr {
+  u8_t addr[ETHARP_HWADDR_LEN];
+} __attribute__((packed));
+
+typedef struct ip4_addr {
+  u32_t addr;
+} ip4_addr_t;
+
+struct netif {
+  ip4_addr_t ip_addr;
+  ip4_addr_t netmask;
+};
+
+extern struct netif *netif_default;
+
+#define SMEMCPY(dst, src, len)    memcpy(dst, src, len)
+#define eth_addr_cmp(addr1, addr2) (memcmp((addr1)->addr, (addr2)->addr, ETHARP_HWADDR_LEN) == 0)
+
+#define lwip_htonl(x) __builtin_bswap32(x)
+#define lwip_ntohl(x) __builtin_bswap32(x)
+#define PP_HTONL(x)   lwip_htonl(x)
+
+#define IPADDR_ANY    ((u32_t)0x00000000UL)
+#define LWIP_MAKEU32(a, b, c, d) (((u32_t)((a) & 0xff) << 24) | ((u32_t)((b) & 0xff) << 16) | ((u32_t)((c) & 0xff) << 8) | (u32_t)((d) & 0xff))
+#define IP4_ADDR(ipaddr, a, b, c, d) (ipaddr)->addr = PP_HTONL(LWIP_MAKEU32(a, b, c, d))
+#define ip4_addr_copy(dest, src) ((dest).addr = (src).addr)
+#define ip4_addr_get_u32(src_ipaddr) ((src_ipaddr)->addr)
+
+char *ip4addr_ntoa(const ip4_addr_t *addr);
+
+ssize_t etharp_find_addr(struct netif *netif, const ip4_addr_t *ipaddr, struct eth_addr **eth_ret, const ip4_addr_t **ip_ret);
+int etharp_get_entry(size_t i, ip4_addr_t **ipaddr, struct netif **netif, struct eth_addr **eth_ret);
+err_t etharp_request(struct netif *netif, const ip4_addr_t *ipaddr);
+
+// Host-side control of the simulated LAN:
+void nativeAddArpHost(ip4_addr_t &ipaddr, struct eth_addr &macAddress);
+void nativeClearArpTable();
+unsigned long nativeGetArpRequestCount();
+
+#endif
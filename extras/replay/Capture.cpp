@@ -0,0 +1,232 @@
+/*
+    Capture.cpp
+    Approximate Library - replay harness
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include "Capture.h"
+
+#include <map>
+
+#define PCAP_MAGIC_US       0xA1B2C3D4
+#define PCAP_MAGIC_NS       0xA1B23C4D
+
+#define RADIOTAP_TSFT       0
+#define RADIOTAP_FLAGS      1
+#define RADIOTAP_RATE       2
+#define RADIOTAP_CHANNEL    3
+#define RADIOTAP_FHSS       4
+#define RADIOTAP_DBM_SIGNAL 5
+
+#define RADIOTAP_FLAG_FCS   0x10
+
+static uint32_t read32(const uint8_t *p, bool swapped) {
+  uint32_t v = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t) p[3] << 24);
+  return(swapped ? __builtin_bswap32(v) : v);
+}
+
+static uint16_t read16le(const uint8_t *p) {
+  return(p[0] | (p[1] << 8));
+}
+
+bool Capture::load(const char *path, int defaultRSSI, int defaultChannel) {
+  bool success = false;
+
+  FILE *file = fopen(path, "rb");
+  if(file) {
+    uint8_t header[24];
+    if(fread(header, 1, sizeof(header), file) == sizeof(header)) {
+      uint32_t magic = read32(header, false);
+      bool swapped = (magic == __builtin_bswap32(PCAP_MAGIC_US) || magic == __builtin_bswap32(PCAP_MAGIC_NS));
+      if(swapped) magic = __builtin_bswap32(magic);
+
+      if(magic == PCAP_MAGIC_US || magic == PCAP_MAGIC_NS) {
+        bool nanoseconds = (magic == PCAP_MAGIC_NS);
+        linkType = read32(header + 20, swapped);
+        success = (linkType == LINKTYPE_IEEE802_11 || linkType == LINKTYPE_IEEE802_11_RADIOTAP);
+
+        uint8_t record[16];
+        while(success && fread(record, 1, sizeof(record), file) == sizeof(record)) {
+          uint32_t seconds = read32(record, swapped);
+          uint32_t fraction = read32(record + 4, swapped);
+          uint32_t includedLength = read32(record + 8, swapped);
+
+          size_t start = data.size();
+          data.resize(start + includedLength);
+          if(fread(&data[start], 1, includedLength, file) != includedLength) break;
+
+          Frame frame;
+          frame.timestampUs = (uint64_t) seconds * 1000000 + (nanoseconds ? fraction / 1000 : fraction);
+          frame.rssi = defaultRSSI;
+          frame.channel = defaultChannel;
+
+          size_t headerLength = 0;
+          bool hasFCS = false;
+          if(linkType == LINKTYPE_IEEE802_11_RADIOTAP) {
+            if(!parseRadiotap(&data[start], includedLength, frame, headerLength, hasFCS)) {
+              data.resize(start);
+              continue;
+            }
+          }
+
+          size_t length = includedLength - headerLength;
+          if(hasFCS && length >= 4) length -= 4;
+
+          if(length < 10) {
+            ++skippedTruncated;
+            data.resize(start);
+          }
+          else if(length > CAPTURE_MAX_PACKET_BYTES - sizeof(wifi_promiscuous_pkt_t) - 4) {
+            ++skippedUnparsable;
+            data.resize(start);
+          }
+          else {
+            frame.offset = start + headerLength;
+            frame.length = length;
+            frames.push_back(frame);
+          }
+        }
+      }
+    }
+    fclose(file);
+  }
+
+  return(success);
+}
+
+bool Capture::parseRadiotap(const uint8_t *buf, size_t len, Frame &frame, size_t &headerLength, bool &hasFCS) {
+  if(len < 8 || buf[0] != 0) {
+    ++skippedUnparsable;
+    return(false);
+  }
+
+  headerLength = read16le(buf + 2);
+  if(headerLength > len) {
+    ++skippedTruncated;
+    return(false);
+  }
+
+  uint32_t present = read32(buf + 4, false);
+
+  //skip any extended presence bitmaps - only fields from the first word are read
+  size_t offset = 8;
+  uint32_t word = present;
+  while((word & 0x80000000) && offset + 4 <= headerLength) {
+    word = read32(buf + offset, false);
+    offset += 4;
+  }
+
+  int frequencyMHz = 0;
+  for(int field = 0; field <= RADIOTAP_DBM_SIGNAL; ++field) {
+    if(!(present & (1 << field))) continue;
+
+    size_t alignment = 1, size = 1;
+    switch(field) {
+      case RADIOTAP_TSFT:       alignment = 8; size = 8; break;
+      case RADIOTAP_CHANNEL:    alignment = 2; size = 4; break;
+      case RADIOTAP_FHSS:       alignment = 1; size = 2; break;
+    }
+
+    offset = (offset + alignment - 1) & ~(alignment - 1);
+    if(offset + size > headerLength) break;
+
+    switch(field) {
+      case RADIOTAP_FLAGS:      hasFCS = (buf[offset] & RADIOTAP_FLAG_FCS) != 0; break;
+      case RADIOTAP_CHANNEL:    frequencyMHz = read16le(buf + offset); break;
+      case RADIOTAP_DBM_SIGNAL: frame.rssi = (int8_t) buf[offset]; break;
+    }
+    offset += size;
+  }
+
+  if(frequencyMHz > 0) {
+    int channel = frequencyToChannel(frequencyMHz);
+    if(channel < 1) {
+      //the ESP8266 and ESP32 cannot receive on 5GHz
+      ++skippedNot24GHz;
+      return(false);
+    }
+    frame.channel = channel;
+  }
+
+  return(true);
+}
+
+int Capture::frequencyToChannel(int frequencyMHz) {
+  int channel = -1;
+
+  if(frequencyMHz == 2484)                              channel = 14;
+  else if(frequencyMHz >= 2412 && frequencyMHz < 2484)  channel = (frequencyMHz - 2407) / 5;
+
+  return(channel);
+}
+
+bool Capture::toPacket(const Frame &frame, wifi_promiscuous_pkt_t *packet, size_t capacity, wifi_promiscuous_pkt_type_t &type) {
+  //the radio reports a length that includes the 4 byte FCS - it is zeroed here
+  size_t packetLength = sizeof(wifi_promiscuous_pkt_t) + frame.length + 4;
+  if(packetLength > capacity) return(false);
+
+  memset(packet, 0, sizeof(wifi_promiscuous_pkt_t));
+  packet -> rx_ctrl.rssi = frame.rssi;
+  packet -> rx_ctrl.channel = frame.channel;
+  packet -> rx_ctrl.sig_len = frame.length + 4;
+  packet -> rx_ctrl.timestamp = (uint32_t) frame.timestampUs;
+
+  memcpy(packet -> payload, &data[frame.offset], frame.length);
+  memset(packet -> payload + frame.length, 0, 4);
+
+  type = ((wifi_80211_fctl *) packet -> payload) -> type;
+
+  return(true);
+}
+
+bool Capture::findBSSID(eth_addr &bssid) {
+  //the most common BSSID amongst beacons is taken to be the local network
+  std::map<uint64_t, int> beaconCount;
+  uint64_t best = 0;
+  int bestCount = 0;
+
+  for(const Frame &frame : frames) {
+    const wifi_80211_mgmt_frame *mgmt = (const wifi_80211_mgmt_frame *) &data[frame.offset];
+    if(frame.length >= sizeof(wifi_80211_mgmt_frame) && mgmt -> fctl.type == WIFI_PKT_MGMT && mgmt -> fctl.subtype == BEACON) {
+      uint64_t key = 0;
+      memcpy(&key, mgmt -> addr3.mac, 6);
+      int count = ++beaconCount[key];
+      if(count > bestCount) {
+        best = key;
+        bestCount = count;
+      }
+    }
+  }
+
+  if(bestCount > 0) memcpy(bssid.addr, &best, 6);
+
+  return(bestCount > 0);
+}
+
+void Capture::findStations(eth_addr &bssid, std::vector<eth_addr> &stations) {
+  std::map<uint64_t, bool> seen;
+
+  for(const Frame &frame : frames) {
+    const wifi_80211_data_frame *data = (const wifi_80211_data_frame *) &this -> data[frame.offset];
+    if(frame.length >= sizeof(wifi_80211_data_frame) && data -> fctl.type == WIFI_PKT_DATA && data -> fctl.ds == 1 && memcmp(data -> da.mac, bssid.addr, 6) == 0) {
+      eth_addr station;
+      memcpy(station.addr, data -> sa.mac, 6);
+
+      uint64_t key = eth_addr_to_uint64(station);
+      if(!seen[key]) {
+        seen[key] = true;
+        stations.push_back(station);
+      }
+    }
+  }
+}
+
+uint64_t Capture::getDurationUs() {
+  uint64_t duration = 0;
+
+  if(frames.size() > 1) duration = frames.back().timestampUs - frames.front().timestampUs;
+
+  return(duration);
+}
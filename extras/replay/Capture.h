@@ -0,0 +1,60 @@
+/*
+    Capture.h
+    Approximate Library - replay harness
+    -
+    Loads 802.11 frames from a pcap file (raw 802.11 or radiotap link types) and
+    rebuilds them as the wifi_promiscuous_pkt_t the ESP32 radio would deliver.
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#ifndef Capture_h
+#define Capture_h
+
+#include <Approximate.h>
+
+#include <vector>
+
+#define LINKTYPE_IEEE802_11           105
+#define LINKTYPE_IEEE802_11_RADIOTAP  127
+
+#define CAPTURE_MAX_PACKET_BYTES      (sizeof(wifi_promiscuous_pkt_t) + 2400)
+
+class Capture {
+  public:
+    typedef struct {
+      size_t offset;          // start of the 802.11 frame within data
+      uint16_t length;        // captured 802.11 bytes, excluding any FCS
+      int8_t rssi;
+      uint8_t channel;
+      uint64_t timestampUs;
+    } Frame;
+
+    int linkType = -1;
+    std::vector<Frame> frames;
+
+    int skippedNot24GHz = 0;
+    int skippedTruncated = 0;
+    int skippedUnparsable = 0;
+
+    bool load(const char *path, int defaultRSSI = -50, int defaultChannel = 1);
+
+    // Returns false if the frame does not fit in capacity bytes.
+    bool toPacket(const Frame &frame, wifi_promiscuous_pkt_t *packet, size_t capacity, wifi_promiscuous_pkt_type_t &type);
+
+    bool findBSSID(eth_addr &bssid);
+
+    // The stations that send data frames to bssid, in the order they are first seen.
+    void findStations(eth_addr &bssid, std::vector<eth_addr> &stations);
+
+    uint64_t getDurationUs();
+
+  private:
+    std::vector<uint8_t> data;
+
+    bool parseRadiotap(const uint8_t *buf, size_t len, Frame &frame, size_t &headerLength, bool &hasFCS);
+    static int frequencyToChannel(int frequencyMHz);
+};
+
+#endif
@@ -0,0 +1,655 @@
+/*
+    replay.cpp
+    Approximate Library - replay harness
+    -
+    Feeds a pcap capture through PacketSniffer exactly as the radio callback would,
+    driving Approximate::loop() on the capture's own clock, then reports throughput,
+    per-frame latency and the events raised.
+
+    Usage: replay [options] capture.pcap
+      --bssid XX:XX:XX:XX:XX:XX   local network (default: most common beacon BSSID)
+      --rssi N                    proximate RSSI threshold (default -40)
+      --rssi-filter NAME          smooth each device's RSSI: raw, ewma, median or kalman (default raw)
+      --capacity N                the size of the table of proximate devices (default APPROXIMATE_MAX_PROXIMATE_DEVICES)
+      --evict POLICY              when that table is full: none, lru or weakest (default none)
+      --hysteresis DB             with --rssi-filter, how far below the threshold a device is kept (default 3)
+      --timeout MS                proximate last seen timeout (default 60000)
+      --active                    also install an active device handler
+      --filter MAC|OUI            only report these active devices (repeatable, implies --active)
+      --repeat N                  replay the capture N times (default 1)
+      --arp N                     resolve IP addresses, with the first N stations on the LAN
+      --prefix P                  the LAN is 192.168.0.0/P, its hosts spread across it (default /24)
+      --scan PCT                  hop channels, hearing only the frames on the current one - PCT of the time
+                                  is shared equally between channels, 100 for plain round-robin
+      --summary MS                report each device's data frames as one SUMMARY event every MS
+      --store PATH                keep devices and resolved hosts in the file PATH, restoring any already there
+      --power-cut S               stop S seconds into the capture, as at a loss of power - no devices depart,
+                                  and what was not yet written to the store is lost
+      --crowd MS                  estimate the distinct devices in each RSSI zone over a sliding window of MS, and
+                                  compare the estimates with exact counts (not with --filter or --summary)
+      --talkers MS                report the devices with the most data every MS, and compare them with exact
+                                  counts (not with --filter or --summary)
+      --fingerprint               follow devices that probe from a new random MAC address each scan
+      --deferred                  queue frames in the callback, parse them in loop()
+      --loop-interval MS          call loop() at most every MS of capture time (default 0)
+      --clock-start MS            millis() at the start of the capture (default 0) - try
+                                  4294900000 to replay across the 49.7 day wrap of millis()
+      --expect-no-alloc           fail if a frame that raised no ARRIVE touched the heap
+      --stats                     print the library's own counters and latency histograms
+      --events                    print every event
+      --verbose                   show the library's Serial output
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include <Approximate.h>
+#include "Capture.h"
+
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <vector>
+
+Approximate approx;
+
+//every heap allocation is counted, so the per-frame path can be shown to be allocation free
+static unsigned long allocationCount = 0;
+
+void *operator new(size_t size) {
+  ++allocationCount;
+  void *p = malloc(size ? size : 1);
+  if(!p) throw std::bad_alloc();
+  return(p);
+}
+
+void *operator new[](size_t size) {
+  return(operator new(size));
+}
+
+void operator delete(void *p) noexcept {
+  free(p);
+}
+
+void operator delete[](void *p) noexcept {
+  free(p);
+}
+
+static bool printEvents = false;
+static unsigned long eventCount[Approximate::SUMMARY + 1] = {0};
+static unsigned long summarisedFrames = 0;
+static unsigned long eventsWithIPAddress = 0;
+
+//every device an event was raised for - allocated up front
+static MacMap seenDevices;
+
+static void onDevice(Device *device, Approximate::DeviceEvent event, const char *handlerName) {
+  if(event <= Approximate::SUMMARY) ++eventCount[event];
+  if(event == Approximate::SUMMARY) summarisedFrames += device -> getTrafficSummary() -> getFrames();
+
+  eth_addr macAddress;
+  device -> getMacAddress(macAddress);
+  seenDevices.put(eth_addr_to_uint64(macAddress), 0);
+  if(device -> hasIPAddress()) ++eventsWithIPAddress;
+
+  if(printEvents) {
+    char macAddress[18], ipAddress[16] = "";
+    printf("%10lu  %-9s %-8s %s %4i %s", millis(), handlerName, Approximate::toString(event).c_str(), device -> getMacAddressAs_c_str(macAddress), device -> getRSSI(false), device -> getIPAddressAs_c_str(ipAddress));
+    if(event == Approximate::SUMMARY) {
+      TrafficSummary *summary = device -> getTrafficSummary();
+      printf(" up %lu B/%lu  down %lu B/%lu  rssi %i..%i mean %i", (unsigned long) summary -> getUploadBytes(), (unsigned long) summary -> getUploadFrames(),
+        (unsigned long) summary -> getDownloadBytes(), (unsigned long) summary -> getDownloadFrames(), summary -> getRSSIMin(), summary -> getRSSIMax(), summary -> getRSSIMean());
+    }
+    printf("\n");
+  }
+}
+
+//devices that have departed, to count those that arrive again - allocated up front, so as not to count against the frames
+static MacMap departedDevices;
+static unsigned long rearrivalCount = 0;
+
+static void onProximateDevice(Device *device, Approximate::DeviceEvent event) {
+  eth_addr macAddress;
+  device -> getMacAddress(macAddress);
+  uint64_t key = eth_addr_to_uint64(macAddress);
+
+  if(event == Approximate::ARRIVE && departedDevices.contains(key)) ++rearrivalCount;
+  else if(event == Approximate::DEPART) departedDevices.put(key, 0);
+
+  onDevice(device, event, "proximate");
+}
+
+static void onActiveDevice(Device *device, Approximate::DeviceEvent event) {
+  onDevice(device, event, "active");
+}
+
+//the last time each device was seen in each RSSI zone, for an exact count to compare with the library's estimate -
+//allocated up front
+static const int CROWD_ZONES = 4;
+static const int crowdZoneRSSI[CROWD_ZONES] = { APPROXIMATE_INTIMATE_RSSI, APPROXIMATE_PERSONAL_RSSI, APPROXIMATE_SOCIAL_RSSI, APPROXIMATE_PUBLIC_RSSI };
+struct CrowdSighting {
+  uint32_t lastSeenAtMs[CROWD_ZONES];
+  bool seen[CROWD_ZONES];
+};
+static MacMap crowdDevices;
+static std::vector<CrowdSighting> crowdSightings;
+static bool active = false;
+
+struct CrowdError {
+  unsigned long samples = 0;
+  double exactSum = 0;
+  double errorSum = 0;
+  double errorMax = 0;
+};
+static CrowdError crowdErrors[CROWD_ZONES];
+
+//the bytes and frames of each device over the current interval, for exact counts to compare with the library's
+//heavy talkers - allocated up front
+static MacMap talkerDevices;
+static std::vector<TalkerSketch::Talker> exactTalkers;
+static std::vector<TalkerSketch::Talker> sortedTalkers;
+static unsigned long talkerReports = 0;
+static double talkerRecallSum = 0;
+static double talkerErrorSum = 0, talkerErrorMax = 0;
+static unsigned long talkerErrorCount = 0;
+static double talkerBoundSum = 0;
+
+static bool crowdCounting = false;
+static bool talkerCounting = false;
+
+static void countCrowdDevice(Device *device) {
+  //as the library counts them: the frames a device sent, in its own zone and all those beyond
+  if(!device -> isDownloading()) {
+    eth_addr macAddress;
+    device -> getMacAddress(macAddress);
+    uint64_t key = eth_addr_to_uint64(macAddress);
+
+    uint32_t n;
+    if(!crowdDevices.get(key, n) && crowdSightings.size() < crowdSightings.capacity() && crowdDevices.put(key, crowdSightings.size())) {
+      n = crowdSightings.size();
+      crowdSightings.push_back(CrowdSighting());
+    }
+    if(n < crowdSightings.size()) {
+      for(int zone = CROWD_ZONES - 1; zone >= 0 && device -> getRSSI() > crowdZoneRSSI[zone]; --zone) {
+        crowdSightings[n].lastSeenAtMs[zone] = millis();
+        crowdSightings[n].seen[zone] = true;
+      }
+    }
+  }
+}
+
+static void countTalkerDevice(Device *device) {
+  eth_addr macAddress;
+  device -> getMacAddress(macAddress);
+  uint64_t key = eth_addr_to_uint64(macAddress);
+
+  uint32_t n;
+  if(!talkerDevices.get(key, n) && exactTalkers.size() < exactTalkers.capacity() && talkerDevices.put(key, exactTalkers.size())) {
+    n = exactTalkers.size();
+    exactTalkers.push_back({ macAddress, 0, 0, 0 });
+  }
+  if(n < exactTalkers.size()) {
+    if(device -> isUploading()) exactTalkers[n].uploadBytes += device -> getPayloadSizeBytes();
+    else exactTalkers[n].downloadBytes += device -> getPayloadSizeBytes();
+    ++exactTalkers[n].frames;
+  }
+}
+
+//every frame the library parses, for the exact counts
+static void onCountedDevice(Device *device, Approximate::DeviceEvent event) {
+  if(crowdCounting) countCrowdDevice(device);
+  if(talkerCounting && (event == Approximate::SEND || event == Approximate::RECEIVE)) countTalkerDevice(device);
+
+  if(active) onActiveDevice(device, event);
+}
+
+static void onHeavyTalkers(TalkerSketch *talkers) {
+  TalkerSketch::Talker reported[APPROXIMATE_TOP_TALKERS];
+  int count = talkers -> getTopTalkers(reported, APPROXIMATE_TOP_TALKERS);
+
+  //the exact top talkers of the interval - as many as were reported
+  sortedTalkers.assign(exactTalkers.begin(), exactTalkers.end());
+  std::sort(sortedTalkers.begin(), sortedTalkers.end(), [](const TalkerSketch::Talker &a, const TalkerSketch::Talker &b) {
+    return(a.uploadBytes + a.downloadBytes > b.uploadBytes + b.downloadBytes);
+  });
+  int k = min(count, (int) sortedTalkers.size());
+
+  if(k > 0) {
+    ++talkerReports;
+    int found = 0;
+    for(int n = 0; n < count; ++n) {
+      uint32_t m;
+      if(talkerDevices.get(eth_addr_to_uint64(reported[n].macAddress), m) && exactTalkers[m].getBytes() > 0) {
+        if(exactTalkers[m].getBytes() >= sortedTalkers[k - 1].getBytes()) ++found;
+
+        double error = ((double) reported[n].getBytes() - exactTalkers[m].getBytes()) / exactTalkers[m].getBytes();
+        talkerErrorSum += error;
+        talkerErrorMax = max(talkerErrorMax, error);
+        ++talkerErrorCount;
+      }
+    }
+    talkerRecallSum += (double) min(found, k) / k;
+    talkerBoundSum += talkers -> getTotalBytes() ? (double) talkers -> getErrorBoundBytes() / talkers -> getTotalBytes() : 0;
+  }
+
+  if(printEvents) {
+    char macAddress[18];
+    for(int n = 0; n < count; ++n) {
+      eth_addr_to_c_str(reported[n].macAddress, macAddress);
+      printf("%10lu  talker    #%-7i %s up %lu B  down %lu B  %lu frames\n", millis(), n + 1, macAddress,
+        (unsigned long) reported[n].uploadBytes, (unsigned long) reported[n].downloadBytes, (unsigned long) reported[n].frames);
+    }
+  }
+
+  talkerDevices.clear();
+  exactTalkers.clear();
+}
+
+static void sampleCrowd() {
+  uint32_t spanMs = approx.getCrowdSpanMs();
+
+  for(int zone = 0; zone < CROWD_ZONES; ++zone) {
+    unsigned long exact = 0;
+    for(CrowdSighting &sighting : crowdSightings) {
+      if(sighting.seen[zone] && (uint32_t) (millis() - sighting.lastSeenAtMs[zone]) <= spanMs) ++exact;
+    }
+
+    if(exact > 0) {
+      double error = fabs((double) approx.getCrowdSize(crowdZoneRSSI[zone]) - exact) / exact;
+      CrowdError &e = crowdErrors[zone];
+      ++e.samples;
+      e.exactSum += exact;
+      e.errorSum += error;
+      e.errorMax = max(e.errorMax, error);
+    }
+  }
+}
+
+static uint64_t nowNs() {
+  return(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static uint64_t percentile(std::vector<uint32_t> &sorted, double p) {
+  if(sorted.empty()) return(0);
+
+  size_t index = (size_t) (p * (sorted.size() - 1) + 0.5);
+  return(sorted[index]);
+}
+
+static void printHistogram(const char *name, LatencyHistogram &histogram) {
+  printf("%-16s%lu, p50 < %lu  p90 < %lu  p99 < %lu  max %lu (ns)\n", name, (unsigned long) histogram.getCount(),
+    (unsigned long) Stats::cyclesToNs(histogram.getPercentile(50) + 1), (unsigned long) Stats::cyclesToNs(histogram.getPercentile(90) + 1),
+    (unsigned long) Stats::cyclesToNs(histogram.getPercentile(99) + 1), (unsigned long) Stats::cyclesToNs(histogram.getMax()));
+}
+
+static void printLibraryStats() {
+  PacketSniffer::Stats snifferStats;
+  PacketSniffer::getStats(snifferStats);
+  Approximate::Stats stats;
+  Approximate::getStats(stats);
+
+  const char *typeNames[] = { "mgmt", "ctrl", "data", "misc" };
+  for(int type = 0; type < 4; ++type) {
+    printf("stats %s      ", typeNames[type]);
+    for(int subtype = 0; subtype < 16; ++subtype) {
+      if(snifferStats.framesBySubtype[type][subtype]) printf(" %i:%lu", subtype, (unsigned long) snifferStats.framesBySubtype[type][subtype]);
+    }
+    printf("\n");
+  }
+  printf("stats frames    %lu rejected by the filter, %lu of other networks, %lu named a device, %lu of those ignored, %lu repeated\n",
+    (unsigned long) snifferStats.framesRejected, (unsigned long) snifferStats.framesOtherNetwork, (unsigned long) stats.framesParsed, (unsigned long) stats.framesIgnored,
+    (unsigned long) stats.framesRepeated);
+  printf("stats beacons   %lu of the local network unchanged, so not parsed again\n", (unsigned long) snifferStats.beaconsUnchanged);
+  printf("stats probes    %lu random addresses merged by fingerprint\n", (unsigned long) stats.probeAddressesMerged);
+  printf("stats table     %lu proximate devices evicted, %lu candidates evicted, %lu devices not tracked as the table was full\n",
+    (unsigned long) stats.proximateEvictions, (unsigned long) stats.candidateEvictions, (unsigned long) stats.proximateTableFull);
+  printf("stats filters   %lu matched, %lu missed\n", (unsigned long) stats.filterMatches, (unsigned long) stats.filterMisses);
+  printf("stats ip        %lu known, %lu ARP lookups, %lu found\n", (unsigned long) stats.ipAddressesCached, (unsigned long) stats.arpLookups, (unsigned long) stats.arpHits);
+  printf("stats handlers  ARRIVE %lu  DEPART %lu  SEND %lu  RECEIVE %lu  PROBE %lu  SUMMARY %lu\n", (unsigned long) stats.handlerCalls[Approximate::ARRIVE], (unsigned long) stats.handlerCalls[Approximate::DEPART],
+    (unsigned long) stats.handlerCalls[Approximate::SEND], (unsigned long) stats.handlerCalls[Approximate::RECEIVE], (unsigned long) stats.handlerCalls[Approximate::PROBE],
+    (unsigned long) stats.handlerCalls[Approximate::SUMMARY]);
+  printHistogram("stats callback  ", snifferStats.callbackCycles);
+  printHistogram("stats parse     ", stats.parseCycles);
+  printHistogram("stats handler   ", stats.handlerCycles);
+}
+
+static void usage() {
+  fprintf(stderr, "usage: replay [--bssid MAC] [--rssi N] [--rssi-filter NAME] [--capacity N] [--evict POLICY] [--hysteresis DB] [--timeout MS] [--active] [--filter MAC|OUI]... [--repeat N] [--arp N] [--prefix P] [--scan PCT] [--summary MS] [--store PATH] [--power-cut S] [--crowd MS] [--talkers MS] [--fingerprint] [--deferred] [--loop-interval MS] [--clock-start MS] [--expect-no-alloc] [--stats] [--events] [--verbose] capture.pcap\n");
+}
+
+int main(int argc, char **argv) {
+  const char *path = NULL;
+  const char *bssidArg = NULL;
+  int rssiThreshold = APPROXIMATE_PERSONAL_RSSI;
+  const char *rssiFilterArg = NULL;
+  int hysteresis = 3;
+  int capacity = APPROXIMATE_MAX_PROXIMATE_DEVICES;
+  const char *evictArg = NULL;
+  int timeoutMs = 60000;
+  int repeat = 1;
+  int arpHosts = -1;
+  int prefix = -1;
+  int scanPercent = -1;
+  int summaryWindowMs = 0;
+  int crowdWindowMs = 0;
+  int talkerIntervalMs = 0;
+  const char *storePath = NULL;
+  double powerCutS = -1;
+  bool verbose = false;
+  bool deferred = false;
+  bool fingerprint = false;
+  bool expectNoAlloc = false;
+  bool printStats = false;
+  unsigned long loopIntervalMs = 0;
+  unsigned long clockStartMs = 0;
+  std::vector<String> filters;
+
+  for(int n = 1; n < argc; ++n) {
+    String arg = argv[n];
+    bool hasValue = (n + 1 < argc);
+
+    if(arg == "--bssid" && hasValue)          bssidArg = argv[++n];
+    else if(arg == "--rssi" && hasValue)      rssiThreshold = atoi(argv[++n]);
+    else if(arg == "--rssi-filter" && hasValue) rssiFilterArg = argv[++n];
+    else if(arg == "--hysteresis" && hasValue)  hysteresis = atoi(argv[++n]);
+    else if(arg == "--capacity" && hasValue)  capacity = atoi(argv[++n]);
+    else if(arg == "--evict" && hasValue)     evictArg = argv[++n];
+    else if(arg == "--timeout" && hasValue)   timeoutMs = atoi(argv[++n]);
+    else if(arg == "--repeat" && hasValue)    repeat = max(1, atoi(argv[++n]));
+    else if(arg == "--arp" && hasValue)       arpHosts = atoi(argv[++n]);
+    else if(arg == "--prefix" && hasValue)    prefix = atoi(argv[++n]);
+    else if(arg == "--scan" && hasValue)      scanPercent = atoi(argv[++n]);
+    else if(arg == "--summary" && hasValue)   summaryWindowMs = atoi(argv[++n]);
+    else if(arg == "--crowd" && hasValue)     crowdWindowMs = atoi(argv[++n]);
+    else if(arg == "--talkers" && hasValue)   talkerIntervalMs = atoi(argv[++n]);
+    else if(arg == "--store" && hasValue)     storePath = argv[++n];
+    else if(arg == "--power-cut" && hasValue) powerCutS = atof(argv[++n]);
+    else if(arg == "--loop-interval" && hasValue) loopIntervalMs = atol(argv[++n]);
+    else if(arg == "--clock-start" && hasValue)   clockStartMs = strtoul(argv[++n], NULL, 10);
+    else if(arg == "--filter" && hasValue)    filters.push_back(argv[++n]);
+    else if(arg == "--active")                active = true;
+    else if(arg == "--deferred")              deferred = true;
+    else if(arg == "--fingerprint")           fingerprint = true;
+    else if(arg == "--stats")                 printStats = true;
+    else if(arg == "--events")                printEvents = true;
+    else if(arg == "--expect-no-alloc")       expectNoAlloc = true;
+    else if(arg == "--verbose")               verbose = true;
+    else if(argv[n][0] != '-' && !path)       path = argv[n];
+    else {
+      usage();
+      return(2);
+    }
+  }
+
+  if(!path) {
+    usage();
+    return(2);
+  }
+
+  RSSIEstimator::Type rssiEstimator = RSSIEstimator::RAW;
+  if(rssiFilterArg) {
+    String name = rssiFilterArg;
+    if(name == "raw")           rssiEstimator = RSSIEstimator::RAW;
+    else if(name == "ewma")     rssiEstimator = RSSIEstimator::EWMA;
+    else if(name == "median")   rssiEstimator = RSSIEstimator::MEDIAN;
+    else if(name == "kalman")   rssiEstimator = RSSIEstimator::KALMAN;
+    else {
+      fprintf(stderr, "replay: unknown RSSI filter %s\n", rssiFilterArg);
+      return(2);
+    }
+  }
+
+  crowdCounting = (crowdWindowMs > 0);
+  talkerCounting = (talkerIntervalMs > 0);
+  if((crowdCounting || talkerCounting) && (!filters.empty() || summaryWindowMs > 0)) {
+    fprintf(stderr, "replay: --crowd and --talkers count devices from the events of every frame, so cannot be used with --filter or --summary\n");
+    return(2);
+  }
+
+  Approximate::EvictionPolicy evictionPolicy = Approximate::NO_EVICTION;
+  if(evictArg) {
+    String name = evictArg;
+    if(name == "none")          evictionPolicy = Approximate::NO_EVICTION;
+    else if(name == "lru")      evictionPolicy = Approximate::EVICT_LEAST_RECENT;
+    else if(name == "weakest")  evictionPolicy = Approximate::EVICT_WEAKEST;
+    else {
+      fprintf(stderr, "replay: unknown eviction policy %s\n", evictArg);
+      return(2);
+    }
+  }
+
+  Serial.quiet = !verbose;
+
+  Capture capture;
+  if(!capture.load(path)) {
+    fprintf(stderr, "replay: cannot read %s (pcap with link type 105 or 127 expected)\n", path);
+    return(1);
+  }
+
+  eth_addr bssid = {{0,0,0,0,0,0}};
+  if(bssidArg) {
+    if(!c_str_to_eth_addr(bssidArg, bssid)) {
+      fprintf(stderr, "replay: bad BSSID %s\n", bssidArg);
+      return(2);
+    }
+  }
+  else if(!capture.findBSSID(bssid)) {
+    fprintf(stderr, "replay: no beacons in capture, use --bssid\n");
+    return(1);
+  }
+  WiFi.nativeSetBSSID(bssid.addr);
+
+  if(prefix >= 0) {
+    if(prefix < 16 || prefix > 30) {
+      fprintf(stderr, "replay: prefix must be from 16 to 30\n");
+      return(2);
+    }
+    uint32_t mask = 0xFFFFFFFFUL << (32 - prefix);
+    WiFi.nativeSetLocalIP(IPAddress(192, 168, 0, 2), IPAddress(mask >> 24, (mask >> 16) & 0xFF, (mask >> 8) & 0xFF, mask & 0xFF));
+  }
+
+  if(arpHosts >= 0) {
+    //the stations found in the capture become hosts on the LAN, from .10 up - on 192.168.1.0/24 by default,
+    //otherwise spaced evenly across 192.168.0.0/prefix
+    uint32_t first = (prefix < 0) ? 0xC0A8010AUL : 0xC0A8000AUL;
+    uint32_t hostCount = (prefix < 0) ? 256 : (1UL << (32 - prefix));
+
+    std::vector<eth_addr> stations;
+    capture.findStations(bssid, stations);
+    int stationCount = min(arpHosts, (int) stations.size());
+    uint32_t spacing = (prefix < 0) ? 1 : max(1UL, (unsigned long) (hostCount - 16) / max(1, stationCount));
+    for(int n = 0; n < stationCount && 10 + n * spacing < hostCount - 1; ++n) {
+      uint32_t address = first + n * spacing;
+      ip4_addr_t ipaddr;
+      IP4_ADDR(&ipaddr, address >> 24, (address >> 16) & 0xFF, (address >> 8) & 0xFF, address & 0xFF);
+      nativeAddArpHost(ipaddr, stations[n]);
+    }
+  }
+
+  nativeSetMillis(clockStartMs);
+
+  if(approx.init("", "", arpHosts >= 0)) {
+    approx.setProximateDeviceHandler(onProximateDevice, rssiThreshold, timeoutMs, evictionPolicy, capacity);
+    if(rssiFilterArg) approx.setProximateRSSIEstimator(rssiEstimator, hysteresis);
+    if(summaryWindowMs > 0) approx.setTrafficSummaryWindowMs(summaryWindowMs);
+    if(storePath && !approx.setPersistence(storePath)) {
+      fprintf(stderr, "replay: cannot use %s as a store\n", storePath);
+      return(1);
+    }
+    departedDevices.init(4096);
+    seenDevices.init(16384);
+    if(crowdCounting) {
+      crowdDevices.init(16384);
+      crowdSightings.reserve(crowdDevices.getMaxCount());
+      approx.setCrowdWindowMs(crowdWindowMs);
+    }
+    if(talkerCounting) {
+      talkerDevices.init(16384);
+      exactTalkers.reserve(talkerDevices.getMaxCount());
+      sortedTalkers.reserve(talkerDevices.getMaxCount());
+      approx.setHeavyTalkerHandler(onHeavyTalkers, talkerIntervalMs);
+    }
+    if(crowdCounting || talkerCounting) approx.setActiveDeviceHandler(onCountedDevice);
+    else if(active || !filters.empty()) approx.setActiveDeviceHandler(onActiveDevice);
+    for(String &filter : filters) {
+      int a, b, c;
+      if(filter.length() == 8 && sscanf(filter.c_str(), "%x:%x:%x", &a, &b, &c) == 3) approx.addActiveDeviceFilter((a << 16) | (b << 8) | c);
+      else approx.addActiveDeviceFilter(filter);
+    }
+    approx.setDeferredParsing(deferred);
+    approx.setProbeFingerprinting(fingerprint);
+    if(scanPercent >= 0) {
+      PacketSniffer::getChannelScheduler() -> init(1000, scanPercent);
+      approx.setChannelScan();
+    }
+    approx.begin();
+  }
+
+  //the first loop() sees the connection and starts the sniffer
+  approx.loop();
+
+  static uint8_t buffer[CAPTURE_MAX_PACKET_BYTES] __attribute__((aligned(4)));
+  wifi_promiscuous_pkt_t *packet = (wifi_promiscuous_pkt_t *) buffer;
+
+  std::vector<uint32_t> latencyNs;
+  latencyNs.reserve(capture.frames.size() * repeat);
+
+  unsigned long framesByType[4] = {0};
+  uint64_t parseNs = 0, loopNs = 0;
+  uint64_t captureUs = capture.getDurationUs();
+  uint64_t firstUs = capture.frames.empty() ? 0 : capture.frames.front().timestampUs;
+  unsigned long loopCalledAtMs = millis();
+  unsigned long frameAllocations = 0, arrivalAllocations = 0;
+  long resolvedAtMs = -1;
+  unsigned long framesNotHeard = 0;
+  unsigned long framesFiltered = 0;
+  unsigned long crowdSampledAtMs = millis();
+
+  bool powerCut = false;
+  for(int r = 0; r < repeat && !powerCut; ++r) {
+    uint64_t offsetUs = r * (captureUs + 1000000);
+
+    for(const Capture::Frame &frame : capture.frames) {
+      if(powerCutS >= 0 && (frame.timestampUs - firstUs + offsetUs) >= powerCutS * 1e6) {
+        powerCut = true;
+        break;
+      }
+
+      wifi_promiscuous_pkt_type_t type;
+      if(!capture.toPacket(frame, packet, sizeof(buffer), type)) continue;
+
+      nativeSetMillis(clockStartMs + (frame.timestampUs - firstUs + offsetUs) / 1000);
+
+      unsigned long allocationsBefore = allocationCount;
+      unsigned long arrivalsBefore = eventCount[Approximate::ARRIVE];
+
+      uint64_t t0 = nowNs();
+      if((uint32_t) (millis() - loopCalledAtMs) >= loopIntervalMs) {
+        approx.loop();
+        loopCalledAtMs = millis();
+      }
+      if(resolvedAtMs < 0 && approx.canResolve()) resolvedAtMs = millis() - clockStartMs;
+      uint64_t t1 = nowNs();
+      loopNs += t1 - t0;
+
+      //while scanning, the radio only hears the channel it is on
+      if(scanPercent >= 0 && frame.channel != PacketSniffer::getInstance() -> getCurrentChannel()) {
+        ++framesNotHeard;
+        continue;
+      }
+      if(!PacketSniffer::isFrameWanted(type, ((wifi_80211_fctl *) packet -> payload) -> subtype)) ++framesFiltered;
+      PacketSniffer::replay(packet, type);
+      uint64_t t2 = nowNs();
+
+      unsigned long allocations = allocationCount - allocationsBefore;
+      if(eventCount[Approximate::ARRIVE] != arrivalsBefore) arrivalAllocations += allocations;
+      else frameAllocations += allocations;
+
+      parseNs += t2 - t1;
+      latencyNs.push_back((uint32_t) min<uint64_t>(t2 - t1, UINT32_MAX));
+      ++framesByType[type & 0x3];
+
+      //sampled as often as the window slides
+      if(crowdWindowMs > 0 && (uint32_t) (millis() - crowdSampledAtMs) >= (uint32_t) crowdWindowMs / APPROXIMATE_CROWD_INTERVALS) {
+        sampleCrowd();
+        crowdSampledAtMs = millis();
+      }
+    }
+  }
+
+  //drain any queued frames, then let every remaining device depart
+  if(!powerCut) {
+    approx.loop();
+    nativeSetMillis(millis() + timeoutMs + 1);
+    approx.loop();
+    if(storePath) approx.end();   //writes what is left to the store
+  }
+
+  size_t frames = latencyNs.size();
+  std::sort(latencyNs.begin(), latencyNs.end());
+
+  printf("capture         %s (link type %i, %.1f s)\n", path, capture.linkType, captureUs / 1e6);
+  printf("frames          %zu replayed (%i not 2.4GHz, %i truncated, %i unparsable skipped)\n", frames, capture.skippedNot24GHz, capture.skippedTruncated, capture.skippedUnparsable);
+  printf("by type         mgmt %lu  ctrl %lu  data %lu  misc %lu\n", framesByType[WIFI_PKT_MGMT], framesByType[WIFI_PKT_CTRL], framesByType[WIFI_PKT_DATA], framesByType[WIFI_PKT_MISC]);
+  printf("frame filter    types 0x%x, control subtypes 0x%04x - %lu frames rejected on entry to the callback\n", PacketSniffer::getInstance() -> getFrameFilter(), PacketSniffer::getInstance() -> getCtrlFrameFilter(), framesFiltered);
+
+  double parseSeconds = parseNs / 1e9;
+  double offeredRate = captureUs > 0 ? capture.frames.size() / (captureUs / 1e6) : 0;
+  double parseRate = parseSeconds > 0 ? frames / parseSeconds : 0;
+  printf("throughput      %.0f frames/s through rxCallback (%.3f s in rxCallback, %.3f s in loop())\n", parseRate, parseSeconds, loopNs / 1e9);
+  if(offeredRate > 0) {
+    printf("offered load    %.0f frames/s in capture, headroom x%.1f on this host\n", offeredRate, parseRate / offeredRate);
+  }
+  printf("latency (ns)    p50 %llu  p90 %llu  p99 %llu  p99.9 %llu  max %llu\n",
+    (unsigned long long) percentile(latencyNs, 0.50), (unsigned long long) percentile(latencyNs, 0.90),
+    (unsigned long long) percentile(latencyNs, 0.99), (unsigned long long) percentile(latencyNs, 0.999),
+    (unsigned long long) (frames ? latencyNs.back() : 0));
+  if(deferred) {
+    printf("frame queue     %lu dropped, high water mark %lu of %i\n", (unsigned long) approx.getDroppedFrameCount(), (unsigned long) PacketSniffer::getInstance() -> getQueueHighWaterMark(), APPROXIMATE_FRAME_QUEUE_LENGTH);
+  }
+  if(arpHosts >= 0) {
+    printf("arp             %lu requests, %lu events for devices with an IP address, sweep ", nativeGetArpRequestCount(), eventsWithIPAddress);
+    if(resolvedAtMs >= 0) printf("complete %.1f s into the capture\n", resolvedAtMs / 1e3);
+    else printf("%i%% complete\n", approx.getResolveProgress());
+  }
+  printf("heap            %lu allocations on frames raising ARRIVE, %lu on all other frames\n", arrivalAllocations, frameAllocations);
+  printf("events          ARRIVE %lu  DEPART %lu  SEND %lu  RECEIVE %lu  PROBE %lu  SUMMARY %lu (%lu frames summarised, per handler)\n",
+    eventCount[Approximate::ARRIVE], eventCount[Approximate::DEPART], eventCount[Approximate::SEND], eventCount[Approximate::RECEIVE], eventCount[Approximate::PROBE],
+    eventCount[Approximate::SUMMARY], summarisedFrames);
+  printf("proximate       %lu arrivals of devices that had already departed\n", rearrivalCount);
+  if(storePath) {
+    DeviceStore *store = approx.getDeviceStore();
+    printf("store           %lu entries restored, %lu in the log after %lu compactions%s\n", (unsigned long) store -> getLoadedCount(),
+      (unsigned long) store -> getEntryCount(), (unsigned long) store -> getCompactionCount(), powerCut ? " - power cut" : "");
+  }
+  if(crowdWindowMs > 0) {
+    printf("crowd           %i ms window in %i intervals, %i bytes for each of %i zones\n", approx.getCrowdWindowMs(), APPROXIMATE_CROWD_INTERVALS, (int) CrowdCounter::getSizeBytes(), CROWD_ZONES);
+    for(int zone = 0; zone < CROWD_ZONES; ++zone) {
+      CrowdError &e = crowdErrors[zone];
+      printf("crowd %4i dBm  %lu samples, %.1f devices exactly on average, estimate error mean %.1f%% max %.1f%%\n", crowdZoneRSSI[zone], e.samples,
+        e.samples ? e.exactSum / e.samples : 0, e.samples ? 100 * e.errorSum / e.samples : 0, 100 * e.errorMax);
+    }
+  }
+  if(talkerCounting) {
+    printf("talkers         %lu reports of up to %i devices in %i bytes - %.0f%% of the exact top talkers reported, bytes over by mean %.1f%% max %.1f%% (bound %.1f%% of all bytes)\n",
+      talkerReports, APPROXIMATE_TOP_TALKERS, (int) TalkerSketch::getSizeBytes(), talkerReports ? 100 * talkerRecallSum / talkerReports : 0,
+      talkerErrorCount ? 100 * talkerErrorSum / talkerErrorCount : 0, 100 * talkerErrorMax, talkerReports ? 100 * talkerBoundSum / talkerReports : 0);
+  }
+  if(scanPercent >= 0) {
+    printf("scan            %lu frames not heard, %i devices seen (%.1f a minute), last dwell (ms)", framesNotHeard, seenDevices.getCount(), seenDevices.getCount() / (repeat * captureUs / 60e6));
+    ChannelScheduler *scheduler = PacketSniffer::getChannelScheduler();
+    for(int channel = 1; channel <= ChannelScheduler::MAX_CHANNEL; ++channel) {
+      if(scheduler -> hasChannel(channel)) printf(" %i:%i", channel, scheduler -> getDwellMs(channel));
+    }
+    printf("\n");
+  }
+
+  if(printStats) printLibraryStats();
+
+  if(expectNoAlloc && frameAllocations > 0) {
+    fprintf(stderr, "replay: %lu heap allocations on the per-frame path\n", frameAllocations);
+    return(3);
+  }
+
+  return(0);
+}
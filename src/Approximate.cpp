@@ -18,15 +18,49 @@ ArpTable *Approximate::arpTable = NULL;
 Approximate::DeviceHandler Approximate::activeDeviceHandler = NULL;
 Approximate::DeviceHandler Approximate::proximateDeviceHandler = NULL;
 Approximate::ChannelStateHandler Approximate::channelStateHandler = NULL;
+Approximate::HeavyTalkerHandler Approximate::heavyTalkerHandler = NULL;
 
 eth_addr Approximate::ownMacAddress = {{0,0,0,0,0,0}};
 
 int Approximate::proximateRSSIThreshold = APPROXIMATE_PERSONAL_RSSI;
 eth_addr Approximate::localBSSID = {{0,0,0,0,0,0}};
 List<Filter *> Approximate::activeDeviceFilterList;
+FilterSet Approximate::activeDeviceFilterSet;
 
-List<Device *> Approximate::proximateDeviceList;
+DeviceTable Approximate::proximateDeviceTable;
+Device Approximate::proximateDeviceView;
 int Approximate::proximateLastSeenTimeoutMs = 60000;
+RSSIEstimator::Type Approximate::proximateRSSIEstimator = RSSIEstimator::RAW;
+int Approximate::proximateRSSIHysteresis = 0;
+Approximate::EvictionPolicy Approximate::proximateEvictionPolicy = Approximate::NO_EVICTION;
+int Approximate::evictionCursor = 0;
+int Approximate::proximateCapacity = APPROXIMATE_MAX_PROXIMATE_DEVICES;
+bool Approximate::allocated = false;
+
+bool Approximate::probeFingerprinting = false;
+uint64_t *Approximate::probeFingerprints = NULL;
+MacMap Approximate::probeFingerprintIndex;
+
+DeviceTable Approximate::trafficSummaryTable;
+TrafficSummary *Approximate::trafficSummaries = NULL;
+Device Approximate::trafficSummaryView;
+int Approximate::trafficSummaryWindowMs = 0;
+
+const int Approximate::crowdZoneRSSI[CROWD_ZONES] = { APPROXIMATE_INTIMATE_RSSI, APPROXIMATE_PERSONAL_RSSI, APPROXIMATE_SOCIAL_RSSI, APPROXIMATE_PUBLIC_RSSI };
+CrowdCounter Approximate::crowdCounters[CROWD_ZONES];
+int Approximate::crowdWindowMs = 0;
+
+TalkerSketch Approximate::talkerSketch;
+int Approximate::heavyTalkerIntervalMs = 0;
+uint32_t Approximate::heavyTalkerIntervalStartedAtMs = 0;
+
+DeviceStore Approximate::deviceStore;
+uint32_t Approximate::deviceStoreFlushedAtMs = 0;
+int Approximate::restoredHostCount = 0;
+
+#if !defined(APPROXIMATE_NO_STATS)
+  Approximate::Stats Approximate::stats;
+#endif
 
 Approximate::Approximate() {
   uint8_t ma[6];
@@ -72,6 +106,7 @@ bool Approximate::initBlind(int channel, uint8_t *bssid, bool ipAddressResolutio
   packetSniffer -> setPacketEventHandler(parsePacket);
   if(csiEnabled) packetSniffer -> setChannelEventHandler(parseChannelStateInformation);
   this -> onlyIndividualDevices = onlyIndividualDevices;
+  updateFrameFilter();
 
   eth_addr networkBSSID; 
   uint8_t_to_eth_addr(bssid, networkBSSID);
@@ -159,6 +194,8 @@ void Approximate::onceWifiStatus(wl_status_t status, voidFnPtrWithFnPtrPayload c
 void Approximate::begin(voidFnPtr thenFnPtr) {
   Serial.println("Approximate::begin");
 
+  allocate();
+
   beginThenFnPtr = thenFnPtr;
   beginPending = true;
 
@@ -169,6 +206,7 @@ void Approximate::begin(voidFnPtr thenFnPtr) {
 void Approximate::end() {
   if (packetSniffer)  packetSniffer -> end();
   if (arpTable)       arpTable -> end();
+  updateDeviceStore(true);
 
   running = false;
 }
@@ -181,7 +219,17 @@ void Approximate::loop() {
 
     if (arpTable)       arpTable -> loop();
 
+    if(snifferPending && !(arpTable && arpTable -> getStatus() == ArpTable::ARP_SCANNING)) {
+      //the sweep of the local network is complete:
+      snifferPending = false;
+      WiFi.disconnect();
+      if(packetSniffer)  packetSniffer -> begin();
+    }
+
     updateProximateDeviceList(); 
+    updateTrafficSummaries();
+    updateHeavyTalkers();
+    updateDeviceStore();
   }
 
   if(currentWifiStatus != WiFi.status()) {
@@ -208,17 +256,21 @@ void Approximate::onWifiStatusChange(wl_status_t oldStatus, wl_status_t newStatu
     }
 
     if(arpTable) {
-      arpTable -> scan(); //blocking
+      arpTable -> scan(); //non-blocking - the sweep continues from loop()
       arpTable -> begin();
     }
 
+    //what was known before a restart - once the local network is sized by scan()
+    restoreDevices();
+
     #if defined(ESP8266)
-      WiFi.disconnect();
+      //the ESP8266 cannot sniff while connected - start the packetSniffer from loop() after any sweep is complete:
+      snifferPending = true;
+    #else
+      //the packetSniffer runs alongside the sweep:
+      if(packetSniffer)  packetSniffer -> begin();
     #endif
 
-    //start the packetSniffer after the scan is complete:
-    if(packetSniffer)  packetSniffer -> begin();
-
     running = true;
   }
 
@@ -382,6 +434,7 @@ void Approximate::addActiveDeviceFilter(int oui) {
 void Approximate::addActiveDeviceFilter(eth_addr &macAddress) {
   Filter *f = new Filter(macAddress);
   activeDeviceFilterList.Add(f);
+  activeDeviceFilterSet.compile(activeDeviceFilterList);
 }
 
 void Approximate::setActiveDeviceFilter(String macAddress) {
@@ -443,34 +496,29 @@ void Approximate::removeActiveDeviceFilter(int oui) {
 }
 
 void Approximate::removeActiveDeviceFilter(eth_addr &macAddress) {
-  for (int n = 0; n < activeDeviceFilterList.Count(); n++) {
+  //walk backwards, so that removal does not skip the next filter when there are multiple matches
+  for (int n = activeDeviceFilterList.Count() - 1; n >= 0; n--) {
     Filter *thisFilter = activeDeviceFilterList[n];
     if(thisFilter -> matches(&macAddress)) {
       activeDeviceFilterList.Remove(n);
       delete thisFilter;
-      n = 0;  //reset the count in case multiple matches
     }
   }
+  activeDeviceFilterSet.compile(activeDeviceFilterList);
 }
 
 void Approximate::removeAllActiveDeviceFilters() {
-  for (int n = 0; n < activeDeviceFilterList.Count(); n++) {
+  for (int n = activeDeviceFilterList.Count() - 1; n >= 0; n--) {
     Filter *thisFilter = activeDeviceFilterList[n];
     activeDeviceFilterList.Remove(n);
     delete thisFilter;
-    n = 0;  //reset
   }
+  activeDeviceFilterSet.compile(activeDeviceFilterList);
 }
 
 bool Approximate::applyDeviceFilters(Device *device) {
-  bool result = false;
-
-  for (int n = 0; n < activeDeviceFilterList.Count() && !result; n++) {
-    Filter *thisFilter = activeDeviceFilterList[n];
-    result = thisFilter -> matches(device);
-  }
-
-  return(result);
+  //the filters as compiled - not a walk of activeDeviceFilterList
+  return(activeDeviceFilterSet.matches(device));
 }
 
 void Approximate::setLocalBSSID(String macAddress) {
@@ -490,12 +538,23 @@ void Approximate::setActiveDeviceHandler(DeviceHandler activeDeviceHandler, bool
     addActiveDeviceFilter(Filter::NONE); 
   }
   Approximate::activeDeviceHandler = activeDeviceHandler;
+  updateFrameFilter();
 }
 
-void Approximate::setProximateDeviceHandler(DeviceHandler deviceHandler, int rssiThreshold, int lastSeenTimeoutMs) {
-  setProximateRSSIThreshold(rssiThreshold);
-  setProximateLastSeenTimeoutMs(lastSeenTimeoutMs);
-  Approximate::proximateDeviceHandler = deviceHandler;
+bool Approximate::setProximateDeviceHandler(DeviceHandler deviceHandler, int rssiThreshold, int lastSeenTimeoutMs, EvictionPolicy evictionPolicy, int capacity) {
+  //after begin() the table is as it allocated it
+  bool success = !deviceHandler || (allocated ? (proximateDeviceTable.isInitialised() && capacity == proximateDeviceTable.getCapacity()) : capacity > 0);
+
+  if(success) {
+    setProximateRSSIThreshold(rssiThreshold);
+    setProximateLastSeenTimeoutMs(lastSeenTimeoutMs);
+    proximateEvictionPolicy = evictionPolicy;
+    if(deviceHandler) proximateCapacity = capacity;
+    Approximate::proximateDeviceHandler = deviceHandler;
+    updateFrameFilter();
+  }
+
+  return(success);
 }
 
 void Approximate::setProximateRSSIThreshold(int proximateRSSIThreshold) {
@@ -506,13 +565,244 @@ void Approximate::setProximateLastSeenTimeoutMs(int proximateLastSeenTimeoutMs)
   Approximate::proximateLastSeenTimeoutMs = proximateLastSeenTimeoutMs;
 }
 
+void Approximate::setProximateRSSIEstimator(RSSIEstimator::Type proximateRSSIEstimator, int proximateRSSIHysteresis) {
+  Approximate::proximateRSSIEstimator = proximateRSSIEstimator;
+  Approximate::proximateRSSIHysteresis = max(proximateRSSIHysteresis, 0);
+}
+
+void Approximate::setChannelScan(bool channelScan) {
+  if(packetSniffer) packetSniffer -> setChannelScan(channelScan);
+  updateFrameFilter();
+}
+
+bool Approximate::isChannelScan() {
+  return(packetSniffer && packetSniffer -> getChannelScan());
+}
+
+bool Approximate::setProbeFingerprinting(bool probeFingerprinting) {
+  bool success = !allocated || !probeFingerprinting || probeFingerprints;
+
+  if(success) {
+    //turned off, every record is forgotten - but the memory is kept, for it to be turned on again
+    if(!probeFingerprinting && probeFingerprints) {
+      memset(probeFingerprints, 0, proximateDeviceTable.getCapacity() * sizeof(uint64_t));
+      probeFingerprintIndex.clear();
+    }
+    Approximate::probeFingerprinting = probeFingerprinting;
+  }
+
+  return(success);
+}
+
+bool Approximate::isProbeFingerprinting() {
+  return(probeFingerprinting);
+}
+
+void Approximate::allocate() {
+  //everything the handlers and windows set so far need, sized once - no more is allocated or freed as frames are parsed
+  if(!allocated) {
+    allocated = true;
+
+    if(proximateDeviceHandler) proximateDeviceTable.init(proximateCapacity);
+
+    if(probeFingerprinting && proximateDeviceTable.isInitialised() && probeFingerprintIndex.init(proximateDeviceTable.getCapacity())) {
+      probeFingerprints = new uint64_t[proximateDeviceTable.getCapacity()]();
+    }
+    else {
+      probeFingerprinting = false;
+    }
+
+    #if defined(APPROXIMATE_MAX_SUMMARY_DEVICES)
+      int summaryCapacity = APPROXIMATE_MAX_SUMMARY_DEVICES;
+    #else
+      int summaryCapacity = proximateCapacity;
+    #endif
+    if(trafficSummaryWindowMs > 0 && trafficSummaryTable.init(summaryCapacity)) {
+      trafficSummaries = new TrafficSummary[trafficSummaryTable.getCapacity()];
+    }
+    else {
+      trafficSummaryWindowMs = 0;
+    }
+
+    bool success = crowdWindowMs > 0;
+    for(int zone = 0; success && zone < CROWD_ZONES; ++zone) {
+      success = crowdCounters[zone].init(crowdWindowMs, millis());
+    }
+    if(!success) crowdWindowMs = 0;
+
+    if(heavyTalkerHandler && talkerSketch.init()) heavyTalkerIntervalStartedAtMs = millis();
+    else heavyTalkerHandler = NULL;
+
+    updateFrameFilter();
+  }
+}
+
+bool Approximate::setTrafficSummaryWindowMs(int trafficSummaryWindowMs) {
+  bool success = !allocated || trafficSummaryWindowMs <= 0 || trafficSummaryTable.isInitialised();
+  if(success) Approximate::trafficSummaryWindowMs = max(trafficSummaryWindowMs, 0);
+
+  return(success);
+}
+
+int Approximate::getTrafficSummaryWindowMs() {
+  return(trafficSummaryWindowMs);
+}
+
+bool Approximate::setCrowdWindowMs(int crowdWindowMs) {
+  //before begin() only the window is kept - after it, the counters begin() allocated are cleared for the new window
+  bool success = crowdWindowMs <= 0 || crowdWindowMs >= APPROXIMATE_CROWD_INTERVALS;
+  if(success && allocated && crowdWindowMs > 0) {
+    for(int zone = 0; success && zone < CROWD_ZONES; ++zone) {
+      success = crowdCounters[zone].isInitialised() && crowdCounters[zone].init(crowdWindowMs, millis());
+    }
+  }
+
+  if(success) {
+    Approximate::crowdWindowMs = max(crowdWindowMs, 0);
+    updateFrameFilter();
+  }
+
+  return(success);
+}
+
+int Approximate::getCrowdWindowMs() {
+  return(crowdWindowMs);
+}
+
+uint32_t Approximate::getCrowdSize(int rssiZone) {
+  //the closest zone that rssiZone is within
+  int zone = 0;
+  while(zone < CROWD_ZONES - 1 && rssiZone < crowdZoneRSSI[zone]) ++zone;
+
+  return(crowdWindowMs ? crowdCounters[zone].getEstimate(millis()) : 0);
+}
+
+uint32_t Approximate::getCrowdSpanMs() {
+  return(crowdWindowMs ? crowdCounters[0].getSpanMs(millis()) : 0);
+}
+
+void Approximate::countCrowd(Device *device) {
+  //the RSSI of a frame sent to the device is the access point's
+  if(!device -> isDownloading()) {
+    int rssi = device -> getRSSI();
+    uint32_t nowMs = millis();
+
+    eth_addr macAddress;
+    device -> getMacAddress(macAddress);
+    uint64_t hash = CrowdCounter::hash(macAddress);
+
+    //counted in its own zone and all those beyond
+    for(int zone = CROWD_ZONES - 1; zone >= 0 && rssi > crowdZoneRSSI[zone]; --zone) {
+      crowdCounters[zone].add(hash, nowMs);
+    }
+  }
+}
+
+void Approximate::setDeferredParsing(bool deferred) {
+  if(packetSniffer) packetSniffer -> setDeferred(deferred);
+}
+
+bool Approximate::isDeferredParsing() {
+  return(packetSniffer && packetSniffer -> isDeferred());
+}
+
+uint32_t Approximate::getDroppedFrameCount() {
+  return(packetSniffer ? packetSniffer -> getDroppedFrameCount() : 0);
+}
+
 void Approximate::setChannelStateHandler(ChannelStateHandler channelStateHandler){
   Approximate::channelStateHandler = channelStateHandler;
+  updateFrameFilter();
+}
+
+bool Approximate::setHeavyTalkerHandler(HeavyTalkerHandler heavyTalkerHandler, int intervalMs) {
+  //after begin() the sketch is only there if a handler was set before it
+  bool success = !heavyTalkerHandler || (intervalMs > 0 && (!allocated || talkerSketch.isInitialised()));
+
+  if(success) {
+    if(heavyTalkerHandler) {
+      talkerSketch.clear();
+      heavyTalkerIntervalMs = intervalMs;
+      heavyTalkerIntervalStartedAtMs = millis();
+    }
+    Approximate::heavyTalkerHandler = heavyTalkerHandler;
+    updateFrameFilter();
+  }
+
+  return(success);
+}
+
+void Approximate::countTalker(Device *device) {
+  eth_addr macAddress;
+  device -> getMacAddress(macAddress);
+
+  int dataFlowBytes = device -> isUploading() ? -device -> getPayloadSizeBytes() : device -> getPayloadSizeBytes();
+  talkerSketch.add(macAddress, dataFlowBytes);
+}
+
+void Approximate::updateHeavyTalkers() {
+  if(heavyTalkerHandler && (uint32_t) (millis() - heavyTalkerIntervalStartedAtMs) >= (uint32_t) heavyTalkerIntervalMs) {
+    heavyTalkerHandler(&talkerSketch);
+
+    talkerSketch.clear();
+    heavyTalkerIntervalStartedAtMs = millis();
+  }
+}
+
+void Approximate::callDeviceHandler(DeviceHandler deviceHandler, Device *device, DeviceEvent event) {
+  APPROXIMATE_STATS_START(startCycles);
+
+  deviceHandler(device, event);
+
+  APPROXIMATE_STATS_COUNT(stats.handlerCalls[event]);
+  APPROXIMATE_STATS_LATENCY(stats.handlerCycles, startCycles);
+}
+
+void Approximate::getStats(Stats &stats) {
+  #if defined(APPROXIMATE_NO_STATS)
+    stats = Stats();
+  #else
+    stats = Approximate::stats;
+  #endif
+}
+
+void Approximate::resetStats() {
+  #if !defined(APPROXIMATE_NO_STATS)
+    stats = Stats();
+  #endif
+}
+
+void Approximate::updateFrameFilter() {
+  //only the frames that some handler can use are passed up from the radio
+  uint8_t frameMask = 0;
+  uint16_t ctrlSubtypeMask = 0;
+
+  if(activeDeviceHandler || proximateDeviceHandler || crowdWindowMs) {
+    frameMask |= PacketSniffer::FRAME_MGMT | PacketSniffer::FRAME_CTRL | PacketSniffer::FRAME_DATA;
+    //CTS and ACK frames do not name their transmitter, so are never parsed
+    ctrlSubtypeMask = (1 << CTRL_RTS) | (1 << CTRL_BLOCK_ACK_REQ) | (1 << CTRL_BLOCK_ACK) | (1 << CTRL_PS_POLL);
+  }
+  if(heavyTalkerHandler) {
+    frameMask |= PacketSniffer::FRAME_DATA;
+  }
+  if(channelStateHandler) {
+    //CSI is measured on frames from the local network - these are left to reach the driver's CSI path
+    frameMask |= PacketSniffer::FRAME_MGMT | PacketSniffer::FRAME_DATA;
+  }
+  if(packetSniffer && packetSniffer -> getChannelScan()) {
+    //the Country IE of the local network's beacons sets the channels to scan
+    frameMask |= PacketSniffer::FRAME_MGMT;
+  }
+  //miscellaneous frames carry nothing that is parsed
+
+  if(packetSniffer) packetSniffer -> setFrameFilter(frameMask, ctrlSubtypeMask);
 }
 
 bool Approximate::parsePacket(wifi_promiscuous_pkt_t *wifi_pkt, uint16_t len, int type, int subtype) {
   bool result = false;
 
+  APPROXIMATE_STATS_START(startCycles);
+
   switch (type) {
     case PKT_MGMT: result = parseMgmtPacket(wifi_pkt, len, subtype); break;
     case PKT_CTRL: result = parseCtrlPacket(wifi_pkt, len, subtype); break;
@@ -520,46 +810,38 @@ bool Approximate::parsePacket(wifi_promiscuous_pkt_t *wifi_pkt, uint16_t len, in
     case PKT_MISC: result = parseMiscPacket(wifi_pkt); break;
   }
 
+  APPROXIMATE_STATS_LATENCY(stats.parseCycles, startCycles);
+
   return(result);
 }
 
 bool Approximate::parseCtrlPacket(wifi_promiscuous_pkt_t *wifi_pkt, uint16_t len, int subtype) {
   bool result = false;
 
-  Device *device = new Device();
+  Device frameDevice;  //per-frame scratch, kept off the heap
+  Device *device = &frameDevice;
   if(PacketSniffer::parseCtrlFrame(wifi_pkt, len, subtype, device)) {
+    APPROXIMATE_STATS_COUNT(stats.framesParsed);
+
     if(!device->matches(ownMacAddress) && (!onlyIndividualDevices || device->isIndividual())) {
       result = true;
 
-      if(proximateDeviceHandler) {
-        Device *proximateDevice = Approximate::getProximateDevice(device);
-        int rssi = device->getRSSI();
+      if(crowdWindowMs) countCrowd(device);
 
-        if(rssi != APPROXIMATE_UNKNOWN_RSSI) {
-          if(rssi > proximateRSSIThreshold) {
-            if(proximateDevice) {
-              proximateDevice->update(device);
-            }
-            else {
-              proximateDevice = new Device(device);
-              proximateDeviceList.Add(proximateDevice);
-              proximateDeviceHandler(proximateDevice, Approximate::ARRIVE);
-            }
-            proximateDeviceHandler(proximateDevice, Approximate::PROBE);
-            proximateDevice->setTimeOutAtMs(millis() + proximateLastSeenTimeoutMs);
-          }
-          else {
-            if(proximateDevice) proximateDevice->update(device);
-          }
-        }
-      }
+      DeviceRecord *proximateRecord = getProximateRecord(device);
+      resolveIPAddress(device, proximateRecord);
+      updateChannelActivity(device, proximateRecord);
+
+      if(proximateDeviceHandler) updateProximateDevice(device, proximateRecord, false);
 
-      if(activeDeviceHandler && (activeDeviceFilterList.IsEmpty() || applyDeviceFilters(device))) {
-        activeDeviceHandler(device, Approximate::PROBE);
+      if(activeDeviceHandler && (activeDeviceFilterSet.isEmpty() || applyDeviceFilters(device))) {
+        callDeviceHandler(activeDeviceHandler, device, Approximate::PROBE);
       }
     }
+    else {
+      APPROXIMATE_STATS_COUNT(stats.framesIgnored);
+    }
   }
-  delete(device);
 
   return(result);
 }
@@ -567,40 +849,35 @@ bool Approximate::parseCtrlPacket(wifi_promiscuous_pkt_t *wifi_pkt, uint16_t len
 bool Approximate::parseMgmtPacket(wifi_promiscuous_pkt_t *wifi_pkt, uint16_t len, int subtype) {
   bool result = false;
 
-  Device *device = new Device();
+  Device frameDevice;  //per-frame scratch, kept off the heap
+  Device *device = &frameDevice;
   if(PacketSniffer::parseMgmtFrame(wifi_pkt, len, subtype, device)) {
+    APPROXIMATE_STATS_COUNT(stats.framesParsed);
+
     if(!device->matches(ownMacAddress) && (!onlyIndividualDevices || device->isIndividual())) {
-      result = true;
+      DeviceRecord *proximateRecord = getProximateRecord(device);
+      if(!proximateRecord && probeFingerprinting) proximateRecord = mergeProbingDevice(device);
 
-      if(proximateDeviceHandler) {
-        Device *proximateDevice = Approximate::getProximateDevice(device);
-        int rssi = device->getRSSI();
+      //a retransmission of a frame already parsed is not passed on again
+      if(!isRepeatedFrame(wifi_pkt, proximateRecord, false)) {
+        result = true;
 
-        if(rssi != APPROXIMATE_UNKNOWN_RSSI) {
-          if(rssi > proximateRSSIThreshold) {
-            if(proximateDevice) {
-              proximateDevice->update(device);
-            }
-            else {
-              proximateDevice = new Device(device);
-              proximateDeviceList.Add(proximateDevice);
-              proximateDeviceHandler(proximateDevice, Approximate::ARRIVE);
-            }
-            proximateDeviceHandler(proximateDevice, Approximate::PROBE);
-            proximateDevice->setTimeOutAtMs(millis() + proximateLastSeenTimeoutMs);
-          }
-          else {
-            if(proximateDevice) proximateDevice->update(device);
-          }
-        }
-      }
+        if(crowdWindowMs) countCrowd(device);
+
+        resolveIPAddress(device, proximateRecord);
+        updateChannelActivity(device, proximateRecord);
 
-      if(activeDeviceHandler && (activeDeviceFilterList.IsEmpty() || applyDeviceFilters(device))) {
-        activeDeviceHandler(device, Approximate::PROBE);
+        if(proximateDeviceHandler) updateProximateDevice(device, proximateRecord, false);
+
+        if(activeDeviceHandler && (activeDeviceFilterSet.isEmpty() || applyDeviceFilters(device))) {
+          callDeviceHandler(activeDeviceHandler, device, Approximate::PROBE);
+        }
       }
     }
+    else {
+      APPROXIMATE_STATS_COUNT(stats.framesIgnored);
+    }
   }
-  delete(device);
 
   return(result);
 }
@@ -608,42 +885,41 @@ bool Approximate::parseMgmtPacket(wifi_promiscuous_pkt_t *wifi_pkt, uint16_t len
 bool Approximate::parseDataPacket(wifi_promiscuous_pkt_t *wifi_pkt, uint16_t payloadLengthBytes) {
   bool result = false;
 
-  Device *device = new Device();
+  Device frameDevice;  //per-frame scratch, kept off the heap
+  Device *device = &frameDevice;
   if(PacketSniffer::parseDataFrame(wifi_pkt, payloadLengthBytes, device)) {
+    APPROXIMATE_STATS_COUNT(stats.framesParsed);
+
     if(!device -> matches(ownMacAddress) && (!onlyIndividualDevices || device -> isIndividual())) {
-      result = true;
-      if(proximateDeviceHandler) {
-        Device *proximateDevice = Approximate::getProximateDevice(device);
-        int rssi = device -> getRSSI();
-
-        if(rssi != APPROXIMATE_UNKNOWN_RSSI) {
-          if(rssi > proximateRSSIThreshold) {
-            if(proximateDevice) {
-              //A known proximate device - already in the list
-              proximateDevice->update(device);
-            }
-            else {
-              //A new proximate device - not already in the list
-              proximateDevice = new Device(device);
+      DeviceRecord *proximateRecord = getProximateRecord(device);
 
-              proximateDeviceList.Add(proximateDevice);
-              proximateDeviceHandler(proximateDevice, Approximate::ARRIVE);
-            }
-            proximateDeviceHandler(proximateDevice, proximateDevice -> isUploading() ? Approximate::SEND : Approximate::RECEIVE);
-            proximateDevice -> setTimeOutAtMs(millis() + proximateLastSeenTimeoutMs);
-          }
-          else {
-            if(proximateDevice) proximateDevice->update(device);
-          }
-        }
-      }
+      //a retransmission of a frame already parsed is not passed on again
+      if(!isRepeatedFrame(wifi_pkt, proximateRecord, device -> isDownloading())) {
+        result = true;
+
+        if(crowdWindowMs) countCrowd(device);
+        if(heavyTalkerHandler) countTalker(device);
+
+        resolveIPAddress(device, proximateRecord);
+        updateChannelActivity(device, proximateRecord);
 
-      if(activeDeviceHandler && (activeDeviceFilterList.IsEmpty() || applyDeviceFilters(device))) {
-        activeDeviceHandler(device, device -> isUploading() ? Approximate::SEND : Approximate::RECEIVE); 
+        Device *proximateTrafficDevice = NULL;
+        if(proximateDeviceHandler) proximateTrafficDevice = updateProximateDevice(device, proximateRecord, true);
+        bool activeTraffic = activeDeviceHandler && (activeDeviceFilterSet.isEmpty() || applyDeviceFilters(device));
+
+        uint8_t handlers = (proximateTrafficDevice ? PROXIMATE_HANDLER : 0) | (activeTraffic ? ACTIVE_HANDLER : 0);
+        if(handlers && !summariseTraffic(device, handlers)) {
+          //reported frame by frame - summaries are off, or there is no room for another
+          DeviceEvent event = device -> isUploading() ? Approximate::SEND : Approximate::RECEIVE;
+          if(proximateTrafficDevice) callDeviceHandler(proximateDeviceHandler, proximateTrafficDevice, event);
+          if(activeTraffic) callDeviceHandler(activeDeviceHandler, device, event);
+        }
       }
     }
+    else {
+      APPROXIMATE_STATS_COUNT(stats.framesIgnored);
+    }
   }
-  delete(device);
 
   return(result);
 }
@@ -655,31 +931,447 @@ bool Approximate::parseMiscPacket(wifi_promiscuous_pkt_t *pkt) {
 void Approximate::parseChannelStateInformation(wifi_csi_info_t *info) {
   #if defined(ESP32)
     if(channelStateHandler) {
-      Channel *channel = new Channel();
-      if(PacketSniffer::parseCSI(info, channel)) {
+      Channel channel;
+      if(PacketSniffer::parseCSI(info, &channel)) {
         //TODO: apply filtering
-        channelStateHandler(channel);
+        channelStateHandler(&channel);
       }
-      delete channel;
     }
   #endif
 }
 
+void Approximate::resolveIPAddress(Device *device, DeviceRecord *proximateRecord) {
+  if(proximateRecord && proximateRecord -> hasIPAddress()) {
+    //already resolved - the ARP table is not consulted again for this device
+    ip4_addr_t ipAddress;
+    proximateRecord -> getIPAddress(ipAddress);
+    device -> setIPAddress(ipAddress);
+    APPROXIMATE_STATS_COUNT(stats.ipAddressesCached);
+  }
+  else {
+    APPROXIMATE_STATS_COUNT(stats.arpLookups);
+    if(ArpTable::lookupIPAddress(device)) APPROXIMATE_STATS_COUNT(stats.arpHits);
+  }
+}
+
+void Approximate::updateChannelActivity(Device *device, DeviceRecord *proximateRecord) {
+  if(packetSniffer -> getChannelScan()) {
+    //while scanning, the channels where devices are - and most of all, tracked devices - are listened to for longer
+    eth_addr macAddress;
+    device -> getMacAddress(macAddress);
+    bool tracked = (proximateRecord && proximateRecord -> isProximate()) || (!activeDeviceFilterSet.isEmpty() && activeDeviceFilterSet.matches(device));
+
+    PacketSniffer::getChannelScheduler() -> onDevice(device -> getChannel(), macAddress, tracked);
+  }
+}
+
+bool Approximate::isRepeatedFrame(wifi_promiscuous_pkt_t *wifi_pkt, DeviceRecord *proximateRecord, bool toDevice) {
+  bool repeated = false;
+
+  //only a device with a record is followed - one that is proximate, or near enough to be a candidate
+  uint16_t sequenceControl;
+  bool retry;
+  if(proximateRecord && PacketSniffer::parseSequenceControl(wifi_pkt, sequenceControl, retry)) {
+    repeated = proximateRecord -> isRepeatedFrame(toDevice, sequenceControl, retry);
+    if(repeated) APPROXIMATE_STATS_COUNT(stats.framesRepeated);
+  }
+
+  return(repeated);
+}
+
+Device *Approximate::updateProximateDevice(Device *device, DeviceRecord *proximateRecord, bool isDataFrame) {
+  Device *trafficDevice = NULL;
+  int rssi = device -> getRSSI();
+
+  //a device evicted is no longer followed - it departs from loop()
+  if(rssi != APPROXIMATE_UNKNOWN_RSSI && !(proximateRecord && proximateRecord -> isEvicted())) {
+    //a device arrives once its estimated RSSI is above the threshold, and is kept while it stays above the band below it
+    int lowerRSSIThreshold = proximateRSSIThreshold - proximateRSSIHysteresis;
+
+    //the RSSI of a frame sent to the device is the access point's - so only the RAW estimate takes it as the device's own
+    bool isOwnRSSI = !(isDataFrame && device -> isDownloading()) || proximateRSSIEstimator == RSSIEstimator::RAW;
+
+    bool added = false;
+    if(proximateRecord) {
+      //A known device - already in the table, proximate or a candidate to be
+      proximateDeviceTable.update(proximateRecord, device);
+    }
+    else if(isOwnRSSI && rssi > lowerRSSIThreshold) {
+      //A new candidate - not already in the table, and ignored if the table is full and nothing can make way for it
+      proximateRecord = proximateDeviceTable.add(device);
+      if(!proximateRecord && proximateEvictionPolicy != NO_EVICTION) {
+        //its estimate as it would be once added - a proximate device only makes way for one that would arrive with this frame
+        RSSIEstimator firstEstimate;
+        firstEstimate.reset(proximateRSSIEstimator, lowerRSSIThreshold);
+        int estimate = firstEstimate.update(proximateRSSIEstimator, rssi);
+
+        if(evictProximateRecord(estimate, estimate > proximateRSSIThreshold)) proximateRecord = proximateDeviceTable.add(device);
+      }
+
+      if(proximateRecord) {
+        proximateRecord -> resetRSSIEstimate(proximateRSSIEstimator, lowerRSSIThreshold);
+        proximateRecord -> setProximate(false);
+        proximateDeviceTable.setTimeOutAtMs(proximateRecord, millis() + proximateLastSeenTimeoutMs);
+        added = true;
+      }
+    }
+    if(proximateRecord && probeFingerprinting) updateProbeFingerprint(proximateRecord, device, added);
+
+    if(proximateRecord) {
+      int estimate = isOwnRSSI ? proximateRecord -> updateRSSIEstimate(proximateRSSIEstimator, rssi) : proximateRecord -> getRSSIEstimate();
+
+      bool arrived = !proximateRecord -> isProximate() && estimate > proximateRSSIThreshold;
+      if(arrived) proximateRecord -> setProximate(true);
+
+      bool present = estimate > lowerRSSIThreshold;
+      if(present) proximateDeviceTable.setTimeOutAtMs(proximateRecord, millis() + proximateLastSeenTimeoutMs);
+
+      if(arrived || (present && proximateRecord -> isProximate())) {
+        //the handler is given the record as it now stands
+        proximateDeviceTable.load(proximateRecord, proximateDeviceView);
+        proximateDeviceView.setProbeFingerprint(getProbeFingerprint(proximateRecord));
+
+        if(arrived) callDeviceHandler(proximateDeviceHandler, &proximateDeviceView, Approximate::ARRIVE);
+
+        if(present) {
+          //the caller reports data frames, as SEND or RECEIVE or in a summary
+          if(isDataFrame) trafficDevice = &proximateDeviceView;
+          else callDeviceHandler(proximateDeviceHandler, &proximateDeviceView, Approximate::PROBE);
+        }
+      }
+    }
+  }
+
+  return(trafficDevice);
+}
+
+DeviceRecord *Approximate::mergeProbingDevice(Device *device) {
+  DeviceRecord *proximateRecord = NULL;
+
+  //a new random address - the record of the last seen probing with the same fingerprint, if it has only been seen probing, is given it
+  uint64_t fingerprint = device -> getProbeFingerprint();
+  uint32_t slot;
+  if(fingerprint && device -> isLocal() && probeFingerprintIndex.get(fingerprint, slot)) {
+    eth_addr macAddress;
+    device -> getMacAddress(macAddress);
+
+    proximateRecord = proximateDeviceTable.getAtSlot(slot);
+    if(proximateRecord && probeFingerprints[slot] == fingerprint && proximateDeviceTable.setMacAddress(proximateRecord, macAddress)) {
+      APPROXIMATE_STATS_COUNT(stats.probeAddressesMerged);
+    }
+    else {
+      proximateRecord = NULL;
+    }
+  }
+
+  return(proximateRecord);
+}
+
+void Approximate::updateProbeFingerprint(DeviceRecord *proximateRecord, Device *device, bool added) {
+  //a record keeps a fingerprint only while every frame of it has been a probe request from a random address - a device that
+  //has been seen doing anything else keeps its address, so is never merged into
+  int slot = proximateDeviceTable.getSlot(proximateRecord);
+  uint64_t fingerprint = device -> isLocal() ? device -> getProbeFingerprint() : 0;
+
+  if(slot >= 0 && (added || (probeFingerprints[slot] != 0 && probeFingerprints[slot] != fingerprint))) {
+    unindexProbeFingerprint(slot);
+    probeFingerprints[slot] = fingerprint;
+
+    if(fingerprint) probeFingerprintIndex.put(fingerprint, slot);
+    else proximateRecord -> setChanged();   //kept by a DeviceStore from now on
+  }
+}
+
+void Approximate::unindexProbeFingerprint(int slot) {
+  uint32_t indexedSlot;
+  if(probeFingerprints[slot] && probeFingerprintIndex.get(probeFingerprints[slot], indexedSlot) && (int) indexedSlot == slot) {
+    probeFingerprintIndex.remove(probeFingerprints[slot]);
+  }
+}
+
+uint64_t Approximate::getProbeFingerprint(DeviceRecord *proximateRecord) {
+  int slot = proximateDeviceTable.getSlot(proximateRecord);
+  return((probeFingerprints && slot >= 0) ? probeFingerprints[slot] : 0);
+}
+
+void Approximate::removeProximateRecord(DeviceRecord *proximateRecord) {
+  int slot = proximateDeviceTable.getSlot(proximateRecord);
+  if(probeFingerprints && slot >= 0) {
+    unindexProbeFingerprint(slot);
+    probeFingerprints[slot] = 0;
+  }
+
+  proximateDeviceTable.remove(proximateRecord);
+}
+
+bool Approximate::summariseTraffic(Device *device, uint8_t handlers) {
+  bool success = false;
+
+  if(trafficSummaryWindowMs > 0 && trafficSummaries) {
+    eth_addr macAddress;
+    device -> getMacAddress(macAddress);
+    uint32_t nowMs = millis();
+
+    DeviceRecord *summaryRecord = trafficSummaryTable.get(macAddress);
+    if(summaryRecord && (int32_t) (nowMs - trafficSummaries[trafficSummaryTable.getSlot(summaryRecord)].getFirstFrameAtMs()) >= trafficSummaryWindowMs) {
+      //the window has closed, but loop() has not yet reported it
+      reportTrafficSummary(summaryRecord);
+      summaryRecord = NULL;
+    }
+
+    if(summaryRecord) {
+      trafficSummaryTable.update(summaryRecord, device);
+    }
+    else {
+      //the first frame of a window - ignored if the table is full
+      summaryRecord = trafficSummaryTable.add(device);
+      if(summaryRecord) {
+        trafficSummaries[trafficSummaryTable.getSlot(summaryRecord)].reset();
+        trafficSummaryTable.setTimeOutAtMs(summaryRecord, nowMs + trafficSummaryWindowMs);
+      }
+    }
+
+    if(summaryRecord) {
+      int dataFlowBytes = device -> isUploading() ? -device -> getPayloadSizeBytes() : device -> getPayloadSizeBytes();
+      trafficSummaries[trafficSummaryTable.getSlot(summaryRecord)].add(dataFlowBytes, device -> getRSSI(false), nowMs, handlers);
+      success = true;
+    }
+  }
+
+  return(success);
+}
+
+void Approximate::reportTrafficSummary(DeviceRecord *summaryRecord) {
+  TrafficSummary *trafficSummary = &trafficSummaries[trafficSummaryTable.getSlot(summaryRecord)];
+
+  trafficSummaryTable.load(summaryRecord, trafficSummaryView);
+  *trafficSummaryView.getTrafficSummary() = *trafficSummary;
+
+  //to each handler that would have been sent one of its frames
+  uint8_t handlers = trafficSummary -> getHandlers();
+  if((handlers & PROXIMATE_HANDLER) && proximateDeviceHandler) callDeviceHandler(proximateDeviceHandler, &trafficSummaryView, Approximate::SUMMARY);
+  if((handlers & ACTIVE_HANDLER) && activeDeviceHandler) callDeviceHandler(activeDeviceHandler, &trafficSummaryView, Approximate::SUMMARY);
+
+  trafficSummaryTable.remove(summaryRecord);
+}
+
+void Approximate::updateTrafficSummaries() {
+  if(trafficSummaryTable.isInitialised()) {
+    DeviceRecord *summaryRecord = NULL;
+    while((summaryRecord = trafficSummaryTable.getTimedOut()) != NULL) {
+      reportTrafficSummary(summaryRecord);
+    }
+  }
+}
+
 void Approximate::updateProximateDeviceList() {
   if(packetSniffer && packetSniffer -> isRunning() && proximateLastSeenTimeoutMs > 0) {
     //only update if we have the possibility of new observations
-    Device *proximateDevice = NULL;
-    for (int n = 0; n < proximateDeviceList.Count(); n++) {
-      proximateDevice = proximateDeviceList[n];
+    //only the devices that have timed out are visited - candidates that never arrived leave silently
+    DeviceRecord *proximateRecord = NULL;
+    while((proximateRecord = proximateDeviceTable.getTimedOut()) != NULL) {
+      departProximateRecord(proximateRecord);
+    }
+  }
+}
+
+void Approximate::departProximateRecord(DeviceRecord *proximateRecord) {
+  if(proximateRecord -> isProximate()) {
+    //a summary still open for the device is reported before it departs
+    eth_addr macAddress;
+    proximateRecord -> getMacAddress(macAddress);
+    DeviceRecord *summaryRecord = trafficSummaryTable.isInitialised() ? trafficSummaryTable.get(macAddress) : NULL;
+    if(summaryRecord) reportTrafficSummary(summaryRecord);
+
+    if(deviceStore.isOpen()) {
+      DeviceStore::Entry entry;
+      DeviceStore::toEntry(entry, DeviceStore::FORGET, macAddress);
+      deviceStore.append(entry);
+    }
+
+    proximateDeviceTable.load(proximateRecord, proximateDeviceView);
+    proximateDeviceView.setProbeFingerprint(getProbeFingerprint(proximateRecord));
+    callDeviceHandler(proximateDeviceHandler, &proximateDeviceView, Approximate::DEPART);
+  }
+  removeProximateRecord(proximateRecord);
+}
+
+bool Approximate::evictProximateRecord(int rssiEstimate, bool arriving) {
+  DeviceRecord *evictedRecord = NULL;
+
+  if(proximateEvictionPolicy != NO_EVICTION && proximateDeviceTable.getCount() > 0) {
+    //a sample of the table rather than all of it, from where the last left off - a candidate that has not yet arrived is
+    //preferred to any proximate device, as it leaves without an event; a device that would not arrive only replaces a candidate
+    uint32_t nowMs = millis();
+    long evictedScore = 0;
+    int samples = min(APPROXIMATE_EVICTION_SAMPLES, proximateDeviceTable.getCount());
+    for(int n = 0; n < samples; ++n) {
+      evictionCursor = (evictionCursor + 1) % proximateDeviceTable.getCount();
+      DeviceRecord *record = proximateDeviceTable.get(evictionCursor);
+      if(record -> isEvicted() || (record -> isProximate() && !arriving)) continue;
+
+      //the greater, the better to evict
+      long score = (proximateEvictionPolicy == EVICT_LEAST_RECENT) ? (long) (nowMs - record -> getLastSeenAtMs()) : -record -> getRSSIEstimate();
+      if(!evictedRecord || (evictedRecord -> isProximate() && !record -> isProximate()) || (evictedRecord -> isProximate() == record -> isProximate() && score > evictedScore)) {
+        evictedRecord = record;
+        evictedScore = score;
+      }
+    }
+
+    //only a weaker device makes way for a stronger
+    if(proximateEvictionPolicy == EVICT_WEAKEST && evictedRecord && evictedRecord -> getRSSIEstimate() >= rssiEstimate) evictedRecord = NULL;
+  }
+
+  bool room = false;
+  if(evictedRecord && evictedRecord -> isProximate()) {
+    //this may be the radio's callback - the DEPART event, its summary and the store are left to loop(), where it times
+    //out at once; until then there is no room, and the new device waits for a later frame
+    APPROXIMATE_STATS_COUNT(stats.proximateEvictions);
+    evictedRecord -> setEvicted();
+    proximateDeviceTable.setTimeOutAtMs(evictedRecord, millis() - 1);
+  }
+  else if(evictedRecord) {
+    APPROXIMATE_STATS_COUNT(stats.candidateEvictions);
+    removeProximateRecord(evictedRecord);
+    room = true;
+  }
+  else {
+    APPROXIMATE_STATS_COUNT(stats.proximateTableFull);
+  }
+
+  return(room);
+}
+
+bool Approximate::setPersistence(const char *path) {
+  return(deviceStore.begin(path));
+}
 
-      if(proximateDevice -> hasTimedOut()) {
-        proximateDeviceHandler(proximateDevice, Approximate::DEPART);
+DeviceStore *Approximate::getDeviceStore() {
+  return(&deviceStore);
+}
+
+void Approximate::restoreDevices() {
+  if(deviceStore.isOpen()) {
+    restoredHostCount = 0;
+    deviceStore.load(restoreDevice);
+
+    //the hosts known before stand in for the sweep of the local network
+    if(arpTable && restoredHostCount > 0) arpTable -> skipSweep();
+
+    deviceStoreFlushedAtMs = millis();
+  }
+}
+
+void Approximate::restoreDevice(DeviceStore::Entry &entry) {
+  eth_addr macAddress;
+  memcpy(macAddress.addr, entry.macAddress, 6);
+
+  switch(entry.type) {
+    case DeviceStore::DEVICE:
+      if(proximateDeviceTable.isInitialised()) {
+        //already proximate, so that it does not ARRIVE again - and DEPARTs if it is not seen
+        char ssid[33];
+        memcpy(ssid, entry.ssid, entry.ssidLength);
+        ssid[entry.ssidLength] = '\0';
+
+        eth_addr bssid = {{0,0,0,0,0,0}};
+        Device device(macAddress, bssid, entry.channel, APPROXIMATE_UNKNOWN_RSSI, millis(), 0, entry.ipAddress);
+        device.setSSID(ssid);
+
+        DeviceRecord *proximateRecord = proximateDeviceTable.get(macAddress);
+        if(proximateRecord) proximateDeviceTable.update(proximateRecord, &device);
+        else proximateRecord = proximateDeviceTable.add(&device);
+
+        if(proximateRecord) {
+          proximateRecord -> resetRSSIEstimate(proximateRSSIEstimator, proximateRSSIThreshold);
+          proximateRecord -> setProximate(true);
+          proximateRecord -> takeChanged();
+          proximateDeviceTable.setTimeOutAtMs(proximateRecord, millis() + proximateLastSeenTimeoutMs);
+        }
+      }
+      break;
+
+    case DeviceStore::FORGET: {
+      DeviceRecord *proximateRecord = proximateDeviceTable.get(macAddress);
+      if(proximateRecord) removeProximateRecord(proximateRecord);
+      break;
+    }
+
+    case DeviceStore::HOST:
+      if(arpTable) {
+        ip4_addr_t ipaddr;
+        ipaddr.addr = entry.ipAddress;
+        if(ArpTable::restore(macAddress, ipaddr)) ++restoredHostCount;
+      }
+      break;
+  }
+}
+
+void Approximate::toEntry(DeviceStore::Entry &entry, DeviceRecord *record) {
+  eth_addr macAddress;
+  record -> getMacAddress(macAddress);
+  ip4_addr_t ipAddress;
+  record -> getIPAddress(ipAddress);
+
+  DeviceStore::toEntry(entry, DeviceStore::DEVICE, macAddress, ipAddress.addr, record -> getChannel(), proximateDeviceTable.getSSID(record));
+}
+
+void Approximate::updateDeviceStore(bool now) {
+  if(deviceStore.isOpen() && (now || (uint32_t) (millis() - deviceStoreFlushedAtMs) >= APPROXIMATE_STORE_FLUSH_MS)) {
+    deviceStoreFlushedAtMs = millis();
+    DeviceStore::Entry entry;
+
+    //the proximate devices that have changed since the last time - departures were appended as they happened
+    uint32_t liveCount = 0;
+    for(int n = 0; n < proximateDeviceTable.getCount(); ++n) {
+      DeviceRecord *proximateRecord = proximateDeviceTable.get(n);
+      //a device seen only probing from a random address would not be seen with that address again
+      if(proximateRecord -> isProximate() && !getProbeFingerprint(proximateRecord)) {
+        ++liveCount;
+        if(proximateRecord -> takeChanged()) {
+          toEntry(entry, proximateRecord);
+          deviceStore.append(entry);
+        }
+      }
+    }
+
+    eth_addr macAddress;
+    ip4_addr_t ipaddr;
+    if(arpTable) {
+      liveCount += ArpTable::getHostCount();
 
-        proximateDeviceList.Remove(n);
-        delete proximateDevice;
-        n=0;
+      if(ArpTable::hasChangedHosts()) {
+        for(int slot = 0; slot < ArpTable::getHostSlotCount(); ++slot) {
+          if(ArpTable::getHost(slot, macAddress, ipaddr) && ArpTable::takeChangedHost(ipaddr)) {
+            DeviceStore::toEntry(entry, DeviceStore::HOST, macAddress, ipaddr.addr);
+            deviceStore.append(entry);
+          }
+        }
       }
     }
+
+    if(deviceStore.needsCompaction(liveCount)) {
+      //the log is rewritten as just the state it describes
+      if(deviceStore.beginCompaction()) {
+        for(int n = 0; n < proximateDeviceTable.getCount(); ++n) {
+          DeviceRecord *proximateRecord = proximateDeviceTable.get(n);
+          if(proximateRecord -> isProximate() && !getProbeFingerprint(proximateRecord)) {
+            toEntry(entry, proximateRecord);
+            deviceStore.writeCompaction(entry);
+          }
+        }
+        for(int slot = 0; arpTable && slot < ArpTable::getHostSlotCount(); ++slot) {
+          if(ArpTable::getHost(slot, macAddress, ipaddr)) {
+            DeviceStore::toEntry(entry, DeviceStore::HOST, macAddress, ipaddr.addr);
+            deviceStore.writeCompaction(entry);
+          }
+        }
+        deviceStore.endCompaction();
+      }
+    }
+    else {
+      deviceStore.flush();
+    }
   }
 }
 
@@ -689,7 +1381,7 @@ bool Approximate::isProximateDevice(Device *device) {
   if(device) {
     eth_addr macAddress_eth_addr;
     device -> getMacAddress(macAddress_eth_addr);
-    result = Approximate::getProximateDevice(macAddress_eth_addr);
+    result = isProximateDevice(macAddress_eth_addr);
   }
 
   return(result);
@@ -703,38 +1395,39 @@ bool Approximate::isProximateDevice(String macAddress) {
 }
 
 bool Approximate::isProximateDevice(eth_addr &macAddress) {
-  return(Approximate::getProximateDevice(macAddress));
+  DeviceRecord *proximateRecord = Approximate::getProximateRecord(macAddress);
+  return(proximateRecord && proximateRecord -> isProximate());
 }
 
-Device *Approximate::getProximateDevice(Device *device) {
-  Device *proximateDevice = NULL;
+DeviceRecord *Approximate::getProximateRecord(Device *device) {
+  DeviceRecord *proximateRecord = NULL;
 
   if(device) {
     eth_addr macAddress;
     device -> getMacAddress(macAddress);
-    proximateDevice = getProximateDevice(macAddress);
+    proximateRecord = getProximateRecord(macAddress);
   }
 
-  return(proximateDevice);
+  return(proximateRecord);
 }
 
-Device *Approximate::getProximateDevice(eth_addr &macAddress) {
-  Device *proximateDevice = NULL;
+DeviceRecord *Approximate::getProximateRecord(eth_addr &macAddress) {
+  DeviceRecord *proximateRecord = NULL;
 
-  //Get known proximate device with this mac address:
-  for (int n = 0; n < proximateDeviceList.Count() && !proximateDevice; n++) {
-		if(proximateDeviceList[n] -> matches(macAddress)) {
-      proximateDevice = proximateDeviceList[n];
-    }
-	}
+  //Get known proximate device with this mac address - or a candidate to be one:
+  proximateRecord = proximateDeviceTable.get(macAddress);
 
-  return(proximateDevice);
+  return(proximateRecord);
 }
 
 bool Approximate::canResolve() {
   return(arpTable != NULL && arpTable->getStatus() == ArpTable::ARP_SCANNED);
 }
 
+int Approximate::getResolveProgress() {
+  return(arpTable != NULL ? arpTable -> getScanProgress() : 0);
+}
+
 bool Approximate::canResolve(ip4_addr_t &ipaddr) {
   bool result = false;
 
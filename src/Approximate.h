@@ -16,11 +16,21 @@
 
 #include "Approximate/ArpTable.h"
 #include "Approximate/Channel.h"
+#include "Approximate/ChannelStream.h"
+#include "Approximate/CrowdCounter.h"
 #include "Approximate/Device.h"
+#include "Approximate/DeviceStore.h"
+#include "Approximate/DeviceTable.h"
 #include "Approximate/Filter.h"
+#include "Approximate/FilterSet.h"
+#include "Approximate/InfoElements.h"
+#include "Approximate/MacMap.h"
 #include "Approximate/Network.h"
 #include "Approximate/Packet.h"
 #include "Approximate/PacketSniffer.h"
+#include "Approximate/RSSIEstimator.h"
+#include "Approximate/Stats.h"
+#include "Approximate/TalkerSketch.h"
 
 #include <ListLib.h>              //https://github.com/luisllamasbinaburo/Arduino-List
 
@@ -29,6 +39,13 @@
 #define APPROXIMATE_SOCIAL_RSSI -60
 #define APPROXIMATE_PUBLIC_RSSI -80
 
+#ifndef APPROXIMATE_EVICTION_SAMPLES
+  #define APPROXIMATE_EVICTION_SAMPLES 8    //devices compared to choose one to evict
+#endif
+
+//APPROXIMATE_MAX_SUMMARY_DEVICES, if defined, is how many devices can be summarised at once - otherwise as many as the
+//proximate device table holds
+
 class Approximate {
   public:
     typedef enum {
@@ -44,11 +61,39 @@ class Approximate {
       SEND,
       RECEIVE,
       INACTIVE,
-      PROBE       // Device detected via management frame (probe request/beacon)
+      PROBE,      // Device detected via management frame (probe request/beacon)
+      SUMMARY     // Device's data frames over a window - see setTrafficSummaryWindowMs()
     } DeviceEvent;
 
+    //what becomes of a device that comes into proximity while the table of proximate devices is full
+    typedef enum {
+      NO_EVICTION,          //it is ignored, until another departs
+      EVICT_LEAST_RECENT,   //it takes the place of the device seen least recently
+      EVICT_WEAKEST         //it takes the place of the device with the weakest RSSI, if that is weaker than its own
+    } EvictionPolicy;
+
     typedef void (*DeviceHandler)(Device *device, DeviceEvent event);
     typedef void (*ChannelStateHandler)(Channel *channel);
+    typedef void (*HeavyTalkerHandler)(TalkerSketch *talkers);
+
+    //counters for parsing and the handlers - see Stats.h
+    struct Stats {
+      uint32_t framesParsed = 0;           //frames that named a device
+      uint32_t framesIgnored = 0;          //of those, frames of this device's own MAC address or not an individual device
+      uint32_t framesRepeated = 0;         //and retransmissions of a frame already parsed - see DeviceRecord::isRepeatedFrame()
+      uint32_t probeAddressesMerged = 0;   //new random MAC addresses taken as a device already seen probing - see setProbeFingerprinting()
+      uint32_t proximateEvictions = 0;     //proximate devices that departed to make room for another - see EvictionPolicy
+      uint32_t candidateEvictions = 0;     //and devices not yet proximate that were dropped, without an event
+      uint32_t proximateTableFull = 0;     //devices that could not be tracked, as no other made room
+      uint32_t filterMatches = 0;          //devices that passed the active device filters
+      uint32_t filterMisses = 0;           //and that did not
+      uint32_t ipAddressesCached = 0;      //IP addresses already known for a proximate device
+      uint32_t arpLookups = 0;             //and looked up in the ARP table
+      uint32_t arpHits = 0;                //of those, found
+      uint32_t handlerCalls[SUMMARY + 1] = {0};   //by DeviceEvent
+      LatencyHistogram parseCycles;        //each frame through parsePacket(), handlers included
+      LatencyHistogram handlerCycles;      //each call of a DeviceHandler
+    };
 
     static String toString(DeviceEvent e) {
       switch (e) {
@@ -57,6 +102,7 @@ class Approximate {
         case Approximate::ARRIVE:     return("ARRIVE");
         case Approximate::DEPART:     return("DEPART");
         case Approximate::PROBE:      return("PROBE");
+        case Approximate::SUMMARY:    return("SUMMARY");
         default:                      return("INACTIVE");
       }
     }
@@ -92,6 +138,7 @@ class Approximate {
     wl_status_t triggerWifiStatus = WL_IDLE_STATUS;
 
     bool beginPending = false;
+    bool snifferPending = false;
     voidFnPtr beginThenFnPtr = NULL;
 
     static bool parsePacket(wifi_promiscuous_pkt_t *pkt, uint16_t len, int type, int subtype);
@@ -112,13 +159,81 @@ class Approximate {
 
     static eth_addr localBSSID;
     static List<Filter *> activeDeviceFilterList;
+    static FilterSet activeDeviceFilterSet;
     static bool applyDeviceFilters(Device *device);
 
-    static List<Device *> proximateDeviceList;
-    static Device *getProximateDevice(Device *device);
-    static Device *getProximateDevice(eth_addr &macAddress);
+    static DeviceTable proximateDeviceTable;
+    static Device proximateDeviceView;      //the record a proximate handler is called with, loaded into a Device
+    static Device *updateProximateDevice(Device *device, DeviceRecord *proximateRecord, bool isDataFrame);
+    static bool isRepeatedFrame(wifi_promiscuous_pkt_t *wifi_pkt, DeviceRecord *proximateRecord, bool toDevice);
+    static void departProximateRecord(DeviceRecord *proximateRecord);
+    static void removeProximateRecord(DeviceRecord *proximateRecord);
+
+    static EvictionPolicy proximateEvictionPolicy;
+    static int evictionCursor;              //where in the table the next sample starts
+    static int proximateCapacity;
+
+    //the tables, counters and sketch are allocated by begin(), for what has been set before it - after it, a setter that
+    //would need more memory fails instead
+    static bool allocated;
+    static void allocate();
+    static bool evictProximateRecord(int rssiEstimate, bool arriving);   //arriving - the device would arrive once added; whether there is room now
+
+    static bool probeFingerprinting;
+    static uint64_t *probeFingerprints;     //by the slot of each record in proximateDeviceTable - 0 unless it has only been seen probing from a random MAC address
+    static MacMap probeFingerprintIndex;    //the slot of the last record to be given each fingerprint
+    static DeviceRecord *mergeProbingDevice(Device *device);
+    static void updateProbeFingerprint(DeviceRecord *proximateRecord, Device *device, bool added);
+    static void unindexProbeFingerprint(int slot);
+    static uint64_t getProbeFingerprint(DeviceRecord *proximateRecord);
+    static void resolveIPAddress(Device *device, DeviceRecord *proximateRecord);
+    static void updateChannelActivity(Device *device, DeviceRecord *proximateRecord);
+    static void updateFrameFilter();
+    static void callDeviceHandler(DeviceHandler deviceHandler, Device *device, DeviceEvent event);
+    static DeviceRecord *getProximateRecord(Device *device);
+    static DeviceRecord *getProximateRecord(eth_addr &macAddress);
     static int proximateRSSIThreshold;
     static int proximateLastSeenTimeoutMs;
+    static RSSIEstimator::Type proximateRSSIEstimator;
+    static int proximateRSSIHysteresis;
+
+    //the handlers a summary is for
+    static const uint8_t PROXIMATE_HANDLER = 0x1;
+    static const uint8_t ACTIVE_HANDLER = 0x2;
+
+    static DeviceTable trafficSummaryTable;
+    static TrafficSummary *trafficSummaries;   //by the slot of each record in trafficSummaryTable
+    static Device trafficSummaryView;
+    static int trafficSummaryWindowMs;
+    static bool summariseTraffic(Device *device, uint8_t handlers);
+    static void reportTrafficSummary(DeviceRecord *summaryRecord);
+    static void updateTrafficSummaries();
+
+    //one for each RSSI zone, from APPROXIMATE_INTIMATE_RSSI out to APPROXIMATE_PUBLIC_RSSI - each counts the devices in it and every zone closer
+    static const int CROWD_ZONES = 4;
+    static const int crowdZoneRSSI[CROWD_ZONES];
+    static CrowdCounter crowdCounters[CROWD_ZONES];
+    static int crowdWindowMs;
+    static void countCrowd(Device *device);
+
+    static HeavyTalkerHandler heavyTalkerHandler;
+    static TalkerSketch talkerSketch;
+    static int heavyTalkerIntervalMs;
+    static uint32_t heavyTalkerIntervalStartedAtMs;
+    static void countTalker(Device *device);
+    static void updateHeavyTalkers();
+
+    static DeviceStore deviceStore;
+    static uint32_t deviceStoreFlushedAtMs;
+    static int restoredHostCount;
+    static void restoreDevice(DeviceStore::Entry &entry);
+    void restoreDevices();
+    static void toEntry(DeviceStore::Entry &entry, DeviceRecord *record);
+    void updateDeviceStore(bool now = false);
+
+    #if !defined(APPROXIMATE_NO_STATS)
+      static Stats stats;
+    #endif
 
     void printWiFiStatus();
 
@@ -164,13 +279,57 @@ class Approximate {
 
     bool canResolve(ip4_addr_t &ipaddr);
     bool canResolve();
+    int getResolveProgress();   //percent of the local network swept - canResolve() once 100
 
     void setActiveDeviceHandler(DeviceHandler activeDeviceHandler, bool inclusive = true);
-    void setProximateDeviceHandler(DeviceHandler deviceHandler, int rssiThreshold = APPROXIMATE_PERSONAL_RSSI, int lastSeenTimeoutMs = 60000);
+    //the table of proximate devices holds capacity devices - allocated by begin(), after which it cannot be resized
+    bool setProximateDeviceHandler(DeviceHandler deviceHandler, int rssiThreshold = APPROXIMATE_PERSONAL_RSSI, int lastSeenTimeoutMs = 60000,
+                                   EvictionPolicy evictionPolicy = NO_EVICTION, int capacity = APPROXIMATE_MAX_PROXIMATE_DEVICES);
     void setChannelStateHandler(ChannelStateHandler channelStateHandler);
+    //at the end of each interval, the devices that sent and received the most data in it (see TalkerSketch) - NULL to stop;
+    //after begin(), only if a handler was set before it
+    bool setHeavyTalkerHandler(HeavyTalkerHandler heavyTalkerHandler, int intervalMs = 60000);
 
     static void setProximateRSSIThreshold(int proximateRSSIThreshold);
     static void setProximateLastSeenTimeoutMs(int proximateLastSeenTimeoutMs);
+    //smooth each device's RSSI before it is compared with the threshold - and once arrived, keep it until it falls hysteresis dB below
+    static void setProximateRSSIEstimator(RSSIEstimator::Type proximateRSSIEstimator, int proximateRSSIHysteresis = 3);
+
+    //hop between channels, rather than stay on the local network's - spending longer where there is more activity
+    void setChannelScan(bool channelScan = true);
+    bool isChannelScan();
+
+    //take a device that probes from a new random MAC address each time it scans as the device already seen with the same
+    //fingerprint (see InfoElements) - so that it does not ARRIVE again, nor take another place in the table; after begin(),
+    //only turned on if it was before it
+    static bool setProbeFingerprinting(bool probeFingerprinting = true);
+    static bool isProbeFingerprinting();
+
+    //report each device's data frames as one SUMMARY event per window, rather than a SEND or RECEIVE for each - 0 for the latter;
+    //after begin(), only turned on if it was before it
+    static bool setTrafficSummaryWindowMs(int trafficSummaryWindowMs);
+    static int getTrafficSummaryWindowMs();
+
+    //estimate how many distinct devices have been seen in each RSSI zone over the last window, in fixed memory (see CrowdCounter) - 0 to stop;
+    //after begin(), only turned on if it was before it
+    static bool setCrowdWindowMs(int crowdWindowMs);
+    static int getCrowdWindowMs();
+    //the devices seen with an RSSI above rssiZone - one of APPROXIMATE_INTIMATE_RSSI to APPROXIMATE_PUBLIC_RSSI, or else the zone it is in
+    static uint32_t getCrowdSize(int rssiZone = APPROXIMATE_PUBLIC_RSSI);
+    static uint32_t getCrowdSpanMs();   //the time getCrowdSize() covers now - a little less than the window, as it slides
+
+    //keep proximate devices, their SSIDs and the IP addresses resolved in flash (a file in the host build) - restored
+    //by begin(), before any frame is seen or the local network is swept; call before begin()
+    bool setPersistence(const char *path = APPROXIMATE_STORE_PATH);
+    static DeviceStore *getDeviceStore();
+
+    void setDeferredParsing(bool deferred = true);
+    bool isDeferredParsing();
+    uint32_t getDroppedFrameCount();
+
+    //a snapshot of the counters - PacketSniffer::getStats() has those of the radio callback
+    static void getStats(Stats &stats);
+    static void resetStats();
 
     wl_status_t connectWiFi(String ssid, String password);
     wl_status_t connectWiFi(char *ssid, char *password);
@@ -12,12 +12,33 @@
 ArpTable::ArpStatus ArpTable::status = ARP_UNSCANNED;
 bool ArpTable::running = false;
 
-ip4_addr_t ArpTable::localNetwork;
-uint32_t *ArpTable::cache = new uint32_t[256];
+uint32_t ArpTable::localNetwork = 0;
+uint32_t ArpTable::hostCount = 0;
+uint8_t *ArpTable::knownHosts = NULL;
+uint8_t *ArpTable::changedHosts = NULL;
+volatile bool ArpTable::hostsChanged = false;
+MacMap ArpTable::hosts;
+MacMap ArpTable::unresolved;
+uint64_t ArpTable::lookupQueue[APPROXIMATE_ARP_LOOKUP_QUEUE_LENGTH];
+volatile uint32_t ArpTable::lookupQueueHead = 0;
+volatile uint32_t ArpTable::lookupQueueTail = 0;
+
+#define ARP_LOOKUP_QUEUE_MASK (APPROXIMATE_ARP_LOOKUP_QUEUE_LENGTH - 1)
+
+//On the ESP32 the parse path runs in the Wi-Fi driver's task, alongside loop() - so its reads of the maps are kept
+//apart from loop()'s writes, which move entries as they are deleted. Elsewhere the two never run at once.
+#if defined(ESP32)
+    static portMUX_TYPE arpTableMux = portMUX_INITIALIZER_UNLOCKED;
+    #define ARP_TABLE_LOCK()    portENTER_CRITICAL(&arpTableMux)
+    #define ARP_TABLE_UNLOCK()  portEXIT_CRITICAL(&arpTableMux)
+#else
+    #define ARP_TABLE_LOCK()    do {} while(0)
+    #define ARP_TABLE_UNLOCK()  do {} while(0)
+#endif
 
 #if defined(ESP8266)
     const int ArpTable::minUpdateIntervalMs = 300;  //updating more frequently is unsafe
-#elif defined(ESP32)
+#elif defined(ESP32) || defined(APPROXIMATE_NATIVE)
     const int ArpTable::minUpdateIntervalMs = 50;   //updating more frequently is unsafe
 #endif
 
@@ -29,7 +50,8 @@ ArpTable::ArpTable(int updateIntervalMs, bool repeatedScans) {
 
     this -> repeatedScans = repeatedScans;
 
-    for(int n=0; n<256; ++n) cache[n] = 0;
+    hosts.init(APPROXIMATE_ARP_MAX_HOSTS);
+    unresolved.init(APPROXIMATE_ARP_MAX_UNRESOLVED);
 }
 
 ArpTable* ArpTable::getInstance(int updateIntervalMs, bool repeatedScans) {
@@ -46,13 +68,26 @@ void ArpTable::end() {
 }
 
 void ArpTable::loop() {
-    if(running && WiFi.status() == WL_CONNECTED && millis() > (lastUpdateTimeMs + updateIntervalMs)) {
-        lastUpdateTimeMs = millis();
-        find(scannedDevice, true);
-    
-        if((scannedDevice == 255) && !repeatedScans) end();
-        else {
-            scannedDevice = (scannedDevice + 1) % 256;
+    resolveQueuedLookups();
+
+    if(running && WiFi.status() == WL_CONNECTED && hostCount > 0) {
+        uint32_t sinceLastUpdateMs = (uint32_t) millis() - lastUpdateTimeMs;
+
+        if(status == ARP_SCANNING) {
+            //the initial sweep, at the fastest safe rate:
+            if(sinceLastUpdateMs >= (uint32_t) minUpdateIntervalMs) {
+                lastUpdateTimeMs = millis();
+                sweep();
+            }
+        }
+        else if(sinceLastUpdateMs > (uint32_t) updateIntervalMs) {
+            lastUpdateTimeMs = millis();
+            find(scannedDevice, true);
+        
+            if((scannedDevice == hostCount - 1) && !repeatedScans) end();
+            else {
+                scannedDevice = (scannedDevice + 1) % hostCount;
+            }
         }
     }
 }
@@ -63,27 +98,75 @@ bool ArpTable::isRunning() {
 
 void ArpTable::scan() {
     if(WiFi.status() == WL_CONNECTED) {
+        //size the table from the netmask, up to the limit of APPROXIMATE_ARP_MAX_HOST_BITS - beyond which
+        //only the part of the network around this device's own address is covered
+        IPAddress ip = WiFi.localIP();
+        IPAddress mask = WiFi.subnetMask();
+        uint32_t address = ((uint32_t) ip[0] << 24) | (ip[1] << 16) | (ip[2] << 8) | ip[3];
+        uint32_t hostMask = ~(((uint32_t) mask[0] << 24) | (mask[1] << 16) | (mask[2] << 8) | mask[3]);
+        hostMask &= (1UL << APPROXIMATE_ARP_MAX_HOST_BITS) - 1;
+        if(hostMask == 0) hostMask = 0xFF;    //no netmask - assume a /24
+
+        if(!knownHosts || hostCount != hostMask + 1) {
+            delete[] knownHosts;
+            delete[] changedHosts;
+            hostCount = hostMask + 1;
+            knownHosts = new uint8_t[(hostCount + 7) / 8];
+            changedHosts = new uint8_t[(hostCount + 7) / 8];
+        }
+        memset(knownHosts, 0, (hostCount + 7) / 8);
+        memset(changedHosts, 0, (hostCount + 7) / 8);
+        ARP_TABLE_LOCK();
+        hosts.clear();
+        ARP_TABLE_UNLOCK();
+
+        localNetwork = address & ~hostMask;
+        scannedDevice = 0;
+
         status = ARP_SCANNING;
-        Serial.printf("Building ARP table, takes %i seconds...\t", (minUpdateIntervalMs * 256)/1000);
-        IP4_ADDR(&localNetwork, WiFi.localIP()[0], WiFi.localIP()[1], WiFi.localIP()[2], 0);
+        Serial.printf("Building ARP table of %lu hosts, takes %lu seconds...\n", (unsigned long) hostCount, (unsigned long) (minUpdateIntervalMs * hostCount)/1000);
 
-        //initate a full (blocking) scan:
-        for(int n=0; n<256; ++n) {
-            find(n, true);
-            delay(minUpdateIntervalMs);
-        }
+        //the sweep itself is made one request at a time by loop():
+        sweptDevice = 0;
+        lastUpdateTimeMs = millis() - minUpdateIntervalMs;
+    }
+}
+
+void ArpTable::skipSweep() {
+    if(status == ARP_SCANNING) {
+        //loop()'s repeated scan, one host at a time, still finds any that were not restored
+        Serial.printf("ARP table restored\n");
+        sweptDevice = hostCount;
+        status = ARP_SCANNED;
+    }
+}
 
-        //write results to the cache:
-        for(int n=0; n<256; ++n)    find(n, false);
+void ArpTable::sweep() {
+    //lwIP holds only a few ARP entries - so collect the reply to the last request before making the next
+    if(sweptDevice > 0) find(sweptDevice - 1, false);
 
-        Serial.printf("DONE\n");
+    if(sweptDevice < hostCount) {
+        find(sweptDevice, true);
+        ++sweptDevice;
+    }
+    else {
+        Serial.printf("ARP table DONE\n");
         status = ARP_SCANNED;
     }
 }
 
-bool ArpTable::find(int localDevice, bool requestIfNotFound) {
+int ArpTable::getScanProgress() {
+    int progress = 0;
+
+    if(status == ARP_SCANNED) progress = 100;
+    else if(status == ARP_SCANNING) progress = (sweptDevice * 100) / (hostCount + 1);
+
+    return(progress);
+}
+
+bool ArpTable::find(uint32_t localDevice, bool requestIfNotFound) {
     ip4_addr_t ipaddr;
-    ipaddr.addr = (localNetwork.addr & 0xFFFFFF) | (localDevice << 24);
+    toIPAddress(localDevice, ipaddr);
 
     return(find(ipaddr, requestIfNotFound));
 }
@@ -100,8 +183,9 @@ bool ArpTable::find(ip4_addr_t &ipaddr, bool requestIfNotFound) {
         }
     }
     else {
-        //known - already in ARP table - add to cache
-        cache[(ipaddr.addr >> 24) & 0xFF] = getHash(*eth_ret);
+        //known - already in ARP table - remember it
+        uint32_t localDevice;
+        if(toLocalDevice(ipaddr, localDevice)) remember(localDevice, *eth_ret);
         found = true;
     }
 
@@ -128,51 +212,206 @@ bool ArpTable::lookupIPAddress(Device *device) {
 bool ArpTable::lookupIPAddress(eth_addr &macAddress, ip4_addr_t &ipaddr) {
     bool found = false;
 
-    uint32_t hash = getHash(macAddress);
-    for(int n=0; n<256 && !found; ++n) {
-        if(cache[n] == hash) {
-            ipaddr.addr = (localNetwork.addr & 0xFFFFFF) | (n << 24);
+    uint64_t key = eth_addr_to_uint64(macAddress);
+    uint32_t value;
+    ARP_TABLE_LOCK();
+    found = hosts.get(key, value);
+    //most devices seen are not on the local network - don't look again for a while
+    bool retry = !found && (!unresolved.get(key, value) || (int32_t) ((uint32_t) millis() - value) >= 0);
+    ARP_TABLE_UNLOCK();
+
+    if(found) toIPAddress(value, ipaddr);
+    else if(retry) queueLookup(key);
+
+    return(found);
+}
+
+void ArpTable::queueLookup(uint64_t key) {
+    uint32_t h = lookupQueueHead;
+    uint32_t t = __atomic_load_n(&lookupQueueTail, __ATOMIC_ACQUIRE);
+
+    //full - the address is queued again by a later frame
+    if((h - t) < APPROXIMATE_ARP_LOOKUP_QUEUE_LENGTH) {
+        lookupQueue[h & ARP_LOOKUP_QUEUE_MASK] = key;
+        __atomic_store_n(&lookupQueueHead, h + 1, __ATOMIC_RELEASE);
+    }
+}
+
+void ArpTable::resolveQueuedLookups() {
+    uint32_t t = lookupQueueTail;
+    uint32_t h = __atomic_load_n(&lookupQueueHead, __ATOMIC_ACQUIRE);
+
+    for(; t != h; ++t) {
+        uint64_t key = lookupQueue[t & ARP_LOOKUP_QUEUE_MASK];
+
+        //the same address may have been queued by several frames
+        uint32_t value;
+        if(!hosts.contains(key) && (!unresolved.get(key, value) || (int32_t) ((uint32_t) millis() - value) >= 0)) {
+            eth_addr macAddress;
+            for(int n = 0; n < 6; ++n) macAddress.addr[n] = (key >> ((5 - n) * 8)) & 0xFF;
+
+            ip4_addr_t ipaddr;
+            if(!findInArpTable(macAddress, ipaddr)) {
+                ARP_TABLE_LOCK();
+                if(unresolved.getCount() >= unresolved.getMaxCount() && !unresolved.contains(key)) unresolved.clear();
+                unresolved.put(key, (uint32_t) millis() + APPROXIMATE_ARP_RETRY_MS);
+                ARP_TABLE_UNLOCK();
+            }
+        }
+    }
+
+    __atomic_store_n(&lookupQueueTail, t, __ATOMIC_RELEASE);
+}
+
+bool ArpTable::findInArpTable(eth_addr &macAddress, ip4_addr_t &ipaddr) {
+    bool found = false;
+
+    //lwIP's own table holds only ARP_TABLE_SIZE entries - look through them directly
+    ip4_addr_t *ip_ret;
+    struct netif *netif_ret;
+    struct eth_addr *eth_ret;
+    for(int n=0; n<ARP_TABLE_SIZE && !found; ++n) {
+        if(etharp_get_entry(n, &ip_ret, &netif_ret, &eth_ret) && eth_addr_cmp(&macAddress, eth_ret)) {
+            ip4_addr_copy(ipaddr, *ip_ret);
+
+            uint32_t localDevice;
+            if(toLocalDevice(ipaddr, localDevice)) remember(localDevice, macAddress);
             found = true;
         }
     }
 
-    if(!found) {
-        ip4_addr_t ipaddrProbe;
-        struct eth_addr *eth_ret;
-        const ip4_addr_t *ip_ret;
-        for(int n=0; n<256 && !found; ++n) {
-            ipaddrProbe.addr = (localNetwork.addr & 0xFFFFFF) | (n << 24);
+    return(found);
+}
 
-            if(etharp_find_addr(netif_default, &ipaddrProbe, &eth_ret, &ip_ret) >= 0) {
-                if(eth_addr_cmp(&macAddress, eth_ret)) {
-                    ip4_addr_copy(ipaddr, ipaddrProbe);
-                    found = true;
-                }
+void ArpTable::remember(uint32_t localDevice, eth_addr &macAddress) {
+    if(knownHosts) {
+        uint64_t key = eth_addr_to_uint64(macAddress);
+
+        uint32_t previousDevice;
+        bool wasKnown = hosts.get(key, previousDevice);
+        if(!wasKnown || previousDevice != localDevice) {
+            //this address may have belonged to another device - rare, so finding it may be slow:
+            uint64_t previousKey;
+            if(isKnown(localDevice) && hosts.findKey(localDevice, previousKey)) {
+                ARP_TABLE_LOCK();
+                hosts.remove(previousKey);
+                ARP_TABLE_UNLOCK();
             }
+
+            //or this device had another address:
+            if(wasKnown) setKnown(previousDevice, false);
+
+            ARP_TABLE_LOCK();
+            setKnown(localDevice, hosts.put(key, localDevice));
+            ARP_TABLE_UNLOCK();
+            setBit(changedHosts, localDevice, true);
+            hostsChanged = true;
         }
+        ARP_TABLE_LOCK();
+        unresolved.remove(key);
+        ARP_TABLE_UNLOCK();
+    }
+}
+
+bool ArpTable::restore(eth_addr &macAddress, ip4_addr_t &ipaddr) {
+    bool success = false;
+
+    uint32_t localDevice;
+    if(toLocalDevice(ipaddr, localDevice)) {
+        //on the same network as before - the host is not written back to the store
+        remember(localDevice, macAddress);
+        setBit(changedHosts, localDevice, false);
+        success = isKnown(localDevice);
+    }
+
+    return(success);
+}
+
+bool ArpTable::getHost(int slot, eth_addr &macAddress, ip4_addr_t &ipaddr) {
+    bool found = false;
+
+    uint64_t key;
+    uint32_t localDevice;
+    if(hosts.getEntry(slot, key, localDevice)) {
+        for(int n = 0; n < 6; ++n) macAddress.addr[n] = (key >> ((5 - n) * 8)) & 0xFF;
+        toIPAddress(localDevice, ipaddr);
+        found = true;
     }
 
     return(found);
 }
 
+bool ArpTable::takeChangedHost(ip4_addr_t &ipaddr) {
+    bool changed = false;
+
+    uint32_t localDevice;
+    if(changedHosts && toLocalDevice(ipaddr, localDevice)) {
+        changed = changedHosts[localDevice >> 3] & (1 << (localDevice & 7));
+        setBit(changedHosts, localDevice, false);
+    }
+
+    return(changed);
+}
+
+bool ArpTable::hasChangedHosts() {
+    //cleared on asking - any change after this is seen by the next call
+    bool changed = hostsChanged;
+    hostsChanged = false;
+
+    return(changed);
+}
+
+int ArpTable::getHostSlotCount() {
+    return(hosts.getSlotCount());
+}
+
+int ArpTable::getHostCount() {
+    return(hosts.getCount());
+}
+
 bool ArpTable::contains(ip4_addr_t &ipaddr) {
     bool result = false;
 
-    if((ipaddr.addr & 0xFFFFFF) == (localNetwork.addr & 0xFFFFFF)) {
+    uint32_t localDevice;
+    if(toLocalDevice(ipaddr, localDevice)) {
         //Same subnet
-        result = (cache[(ipaddr.addr >> 24) & 0xFF] != 0);
+        result = isKnown(localDevice);
     }
 
     return(result);
 }
 
-uint32_t ArpTable::getHash(eth_addr &macAddress) {
-    uint32_t hash = 0;
+bool ArpTable::toLocalDevice(const ip4_addr_t &ipaddr, uint32_t &localDevice) {
+    bool result = false;
 
-    //last 4 bytes:
-    hash = (macAddress.addr[2] << 24) | (macAddress.addr[3] << 16) | (macAddress.addr[4] << 8) | (macAddress.addr[5] & 0xFF);
+    if(hostCount > 0) {
+        uint32_t address = lwip_ntohl(ipaddr.addr);
+        if((address & ~(hostCount - 1)) == localNetwork) {
+            localDevice = address & (hostCount - 1);
+            result = true;
+        }
+    }
 
-    return(hash);
+    return(result);
+}
+
+void ArpTable::toIPAddress(uint32_t localDevice, ip4_addr_t &ipaddr) {
+    ipaddr.addr = lwip_htonl(localNetwork | localDevice);
+}
+
+bool ArpTable::isKnown(uint32_t localDevice) {
+    return(knownHosts && localDevice < hostCount && (knownHosts[localDevice >> 3] & (1 << (localDevice & 7))));
+}
+
+void ArpTable::setKnown(uint32_t localDevice, bool known) {
+    setBit(knownHosts, localDevice, known);
+}
+
+void ArpTable::setBit(uint8_t *bits, uint32_t localDevice, bool value) {
+    if(bits && localDevice < hostCount) {
+        if(value) bits[localDevice >> 3] |= (1 << (localDevice & 7));
+        else bits[localDevice >> 3] &= ~(1 << (localDevice & 7));
+    }
 }
 
 ArpTable::ArpStatus ArpTable::getStatus() {
@@ -16,12 +16,47 @@
 #if defined(ESP8266)
     #include <ESP8266WiFi.h>        //https://github.com/esp8266/Arduino
 
-#elif defined(ESP32)
+#elif defined(ESP32) || defined(APPROXIMATE_NATIVE)
     #include <WiFi.h>               //https://github.com/espressif/arduino-esp32/
 
 #endif
 
 #include "Device.h"
+#include "MacMap.h"
+
+//how long a MAC address that could not be resolved is left before it is tried again
+#ifndef APPROXIMATE_ARP_RETRY_MS
+  #define APPROXIMATE_ARP_RETRY_MS 30000
+#endif
+
+//the most hosts on the local network that are swept and remembered - a /20 network (a /22 on the ESP8266);
+//on a larger network only this much of it, around the device's own address, is covered
+#ifndef APPROXIMATE_ARP_MAX_HOST_BITS
+  #if defined(ESP8266)
+    #define APPROXIMATE_ARP_MAX_HOST_BITS 10
+  #else
+    #define APPROXIMATE_ARP_MAX_HOST_BITS 12
+  #endif
+#endif
+
+//how many hosts can be resolved at once
+#ifndef APPROXIMATE_ARP_MAX_HOSTS
+  #if defined(ESP8266)
+    #define APPROXIMATE_ARP_MAX_HOSTS 256
+  #else
+    #define APPROXIMATE_ARP_MAX_HOSTS 1024
+  #endif
+#endif
+
+//how many unresolved MAC addresses are remembered - beyond this they are all forgotten
+#ifndef APPROXIMATE_ARP_MAX_UNRESOLVED
+  #define APPROXIMATE_ARP_MAX_UNRESOLVED 64
+#endif
+
+//how many MAC addresses the parse path can leave for loop() to look up at once - beyond this they wait for a later frame
+#ifndef APPROXIMATE_ARP_LOOKUP_QUEUE_LENGTH
+  #define APPROXIMATE_ARP_LOOKUP_QUEUE_LENGTH 16   //must be a power of two
+#endif
 
 class ArpTable {
     public:
@@ -32,8 +67,21 @@ class ArpTable {
         } ArpStatus;
 
     private:
-        static uint32_t *cache;
-        static ip4_addr_t localNetwork;
+        static uint32_t localNetwork;       //the first address of the local network, in host byte order
+        static uint32_t hostCount;          //a power of two, sized from the netmask
+        static uint8_t *knownHosts;         //a bit for each host on the local network, set if its MAC address is known
+        static uint8_t *changedHosts;       //a bit for each host whose MAC address has changed since takeChangedHost()
+        static volatile bool hostsChanged;
+        static MacMap hosts;                //MAC address -> host
+        static MacMap unresolved;           //MAC address -> when it may next be looked up
+
+        //hosts and unresolved are only written by loop(); the parse path - on the ESP32, the Wi-Fi driver's task - only
+        //reads them, and leaves the MAC addresses it could not resolve in this single-producer/single-consumer ring
+        static uint64_t lookupQueue[APPROXIMATE_ARP_LOOKUP_QUEUE_LENGTH];
+        static volatile uint32_t lookupQueueHead;   //written only by the parse path
+        static volatile uint32_t lookupQueueTail;   //written only by loop()
+        static void queueLookup(uint64_t key);
+        static void resolveQueuedLookups();
 
         static bool running;
         bool repeatedScans = true;
@@ -41,17 +89,27 @@ class ArpTable {
 
         int updateIntervalMs;
         static const int minUpdateIntervalMs;
-        int lastUpdateTimeMs;
+        uint32_t lastUpdateTimeMs;
 
         ArpTable(int updateIntervalMs = 500, bool repeatedScans = true);
         ArpTable(ArpTable const&);
         void operator=(ArpTable const&);
 
-        static bool find(int localDevice, bool requestIfNotFound);
+        static bool find(uint32_t localDevice, bool requestIfNotFound);
         static bool find(ip4_addr_t &ipaddr, bool requestIfNotFound);
-        int scannedDevice = 0;
+        uint32_t scannedDevice = 0;
+        uint32_t sweptDevice = 0;           //progress of the initial sweep started by scan()
+
+        void sweep();
+
+        static void remember(uint32_t localDevice, eth_addr &macAddress);
+        static bool findInArpTable(eth_addr &macAddress, ip4_addr_t &ipaddr);
 
-        static uint32_t getHash(eth_addr &macAddress);
+        static bool toLocalDevice(const ip4_addr_t &ipaddr, uint32_t &localDevice);
+        static void toIPAddress(uint32_t localDevice, ip4_addr_t &ipaddr);
+        static bool isKnown(uint32_t localDevice);
+        static void setKnown(uint32_t localDevice, bool known);
+        static void setBit(uint8_t *bits, uint32_t localDevice, bool value);
 
     public:
         static ArpTable* getInstance(int updateIntervalMs = 1000, bool repeatedScans = true);
@@ -61,11 +119,23 @@ class ArpTable {
         void loop();
         bool isRunning();
         
+        //the IP address of a host already known - one that is not is looked up by the next loop(), for a later frame
         static bool lookupIPAddress(Device *device);
         static bool lookupIPAddress(eth_addr &macAddress, ip4_addr_t &ipaddr);
         bool contains(ip4_addr_t &ipaddr);
         
-        static void scan();
+        void scan();                        //starts a sweep of the local network, continued by loop()
+        void skipSweep();                   //ends the sweep, as if complete - once hosts have been restored
+
+        //for a DeviceStore - a host remembered before a restart, after scan() has sized the local network
+        static bool restore(eth_addr &macAddress, ip4_addr_t &ipaddr);
+        //every host known, 0 <= slot < getHostSlotCount() - and whether it had changed, marking it as not
+        static bool getHost(int slot, eth_addr &macAddress, ip4_addr_t &ipaddr);
+        static bool takeChangedHost(ip4_addr_t &ipaddr);
+        static bool hasChangedHosts();
+        static int getHostSlotCount();
+        static int getHostCount();
+        int getScanProgress();              //percent
 
         ArpTable::ArpStatus getStatus();
 };
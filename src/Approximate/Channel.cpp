@@ -25,13 +25,33 @@ int8_t Channel::getBufferN(int n) {
     return(result);
 }
 
- void Channel::getSubCarrier(int n, float &magnitude, float &phase) {
+const int8_t *Channel::getBuffer() {
+    return(buf);
+}
+
+int Channel::getRSSI() {
+    return(rssi);
+}
+
+void Channel::setRSSI(int rssi) {
+    this -> rssi = rssi;
+}
+
+uint32_t Channel::getTimestampUs() {
+    return(timestampUs);
+}
+
+void Channel::setTimestampUs(uint32_t timestampUs) {
+    this -> timestampUs = timestampUs;
+}
+
+void Channel::getSubCarrier(int n, float &magnitude, float &phase) {
     int8_t a = 0, bi = 0;
     getSubCarrier(n, a, bi);
 
     magnitude = sqrt((a * a) + (bi * bi));
     phase = atan2(bi, a);
- }
+}
 
 void Channel::getSubCarrier(int n, int8_t &a, int8_t &bi) {
     if(n!=0 && n >= -26 && n <= 26) {
@@ -40,4 +60,79 @@ void Channel::getSubCarrier(int n, int8_t &a, int8_t &bi) {
         a = buf[index + 1];
         bi = buf[index];
     }
-}
\ No newline at end of file
+}
+
+void Channel::getSubCarriers(int8_t *a, int8_t *bi) {
+    //buffer format: [-,-], [bi, a](1), ... [bi, a](26), ..., [bi, a](-26), ... [bi, a](-1) - so two runs:
+    const int8_t *lower = buf + 76;     //-26 to -1
+    const int8_t *upper = buf + 4;      //1 to 26
+
+    for(int i = 0; i < 26; ++i) {
+        bi[i] = lower[i * 2];
+        a[i] = lower[(i * 2) + 1];
+        bi[i + 26] = upper[i * 2];
+        a[i + 26] = upper[(i * 2) + 1];
+    }
+}
+
+void Channel::getSubCarriers(uint16_t *magnitude, int16_t *phase) {
+    int8_t a[SUBCARRIERS], bi[SUBCARRIERS];
+    getSubCarriers(a, bi);
+
+    for(int i = 0; i < SUBCARRIERS; ++i) {
+        //alpha max plus beta min - the larger of max and 7/8 max + 1/2 min, within -3% to +1% of the true magnitude
+        uint16_t x = abs(a[i]), y = abs(bi[i]);
+        uint16_t hi = max(x, y), lo = min(x, y);
+        magnitude[i] = max(hi * 16, (hi * 14) + (lo * 8));
+
+        phase[i] = atan2Fixed(bi[i], a[i]);
+    }
+}
+
+void Channel::getSubCarriers(float *magnitude, float *phase) {
+    int8_t a[SUBCARRIERS], bi[SUBCARRIERS];
+    getSubCarriers(a, bi);
+
+    for(int i = 0; i < SUBCARRIERS; ++i) {
+        magnitude[i] = sqrt((a[i] * a[i]) + (bi[i] * bi[i]));
+        phase[i] = atan2(bi[i], a[i]);
+    }
+}
+
+int Channel::getSubCarrierNumber(int i) {
+    int n = 0;
+
+    if(i >= 0 && i < SUBCARRIERS) n = (i < 26) ? i - 26 : i - 25;
+
+    return(n);
+}
+
+//atan(i/64) in milliradians, for i from 0 to 64
+static const uint16_t atanTable[65] = {
+      0,  16,  31,  47,  62,  78,  93, 109, 124, 140, 155, 170, 185, 200, 215, 230,
+    245, 260, 274, 289, 303, 317, 331, 345, 359, 372, 386, 399, 412, 425, 438, 451,
+    464, 476, 488, 500, 512, 524, 536, 547, 559, 570, 581, 592, 602, 613, 623, 633,
+    644, 653, 663, 673, 682, 692, 701, 710, 719, 728, 736, 745, 753, 761, 770, 778,
+    785
+};
+
+int16_t Channel::atan2Fixed(int8_t y, int8_t x) {
+    int16_t result = 0;
+
+    int16_t ax = abs(x), ay = abs(y);
+    if(ax != 0 || ay != 0) {
+        //the angle within the first octant, from the ratio of the smaller to the larger, interpolated in the table:
+        bool steep = (ay > ax);
+        uint16_t ratio = ((steep ? ax : ay) << 12) / (steep ? ay : ax);    //0 to 4096
+        uint16_t i = ratio >> 6, fraction = ratio & 0x3F;
+        int16_t angle = atanTable[i];
+        if(fraction) angle += ((atanTable[i + 1] - atanTable[i]) * fraction) >> 6;
+
+        //then unfolded into the quadrant:
+        if(steep) angle = 1571 - angle;
+        if(x < 0) angle = 3142 - angle;
+        result = (y < 0) ? -angle : angle;
+    }
+
+    return(result);
+}
@@ -19,14 +19,39 @@
 class Channel : public Network {
     private:
         int8_t buf[128];
+        int rssi = APPROXIMATE_UNKNOWN_RSSI;
+        uint32_t timestampUs = 0;           //when received, on the radio's own clock
+
+        static int16_t atan2Fixed(int8_t y, int8_t x);
     public:
+        //the subcarriers -26 to -1 then 1 to 26, in the order the bulk getSubCarriers() fill their arrays
+        static const int SUBCARRIERS = 52;
+
+        //the fixed-point units: magnitudes are in sixteenths, phases in milliradians (-3142 to 3142)
+        static const int MAGNITUDE_SCALE = 16;
+        static const int PHASE_SCALE = 1000;
+
         Channel();
 
         void setBuffer(int8_t *buf);
         int8_t getBufferN(int n);
+        const int8_t *getBuffer();
+
+        int getRSSI();
+        void setRSSI(int rssi);
+
+        uint32_t getTimestampUs();
+        void setTimestampUs(uint32_t timestampUs);
 
         void getSubCarrier(int n, float &magnitude, float &phase);
         void getSubCarrier(int n, int8_t &a, int8_t &bi);
+
+        //every subcarrier in one pass, each array of SUBCARRIERS:
+        void getSubCarriers(int8_t *a, int8_t *bi);
+        void getSubCarriers(uint16_t *magnitude, int16_t *phase);   //fixed-point - within 3% and 2 milliradians
+        void getSubCarriers(float *magnitude, float *phase);        //exact, for reference, but slower
+
+        static int getSubCarrierNumber(int i);
 };
 
 #endif
\ No newline at end of file
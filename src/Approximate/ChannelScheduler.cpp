@@ -0,0 +1,160 @@
+/*
+    ChannelScheduler.cpp
+    Approximate Library
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include "ChannelScheduler.h"
+
+ChannelScheduler::ChannelScheduler() {
+  init();
+}
+
+void ChannelScheduler::init(int meanDwellMs, int explorationPercent) {
+  this -> meanDwellMs = max(meanDwellMs, 10);
+  this -> explorationPercent = min(max(explorationPercent, 1), 100);
+
+  memset(activity, 0, sizeof(activity));
+  setChannels(0x3FFE);   //1 to 13
+
+  currentChannel = 0;
+}
+
+void ChannelScheduler::setChannels(uint16_t channels) {
+  channels &= (1 << (MAX_CHANNEL + 1)) - 2;
+
+  if(channels != 0) {
+    this -> channels = channels;
+
+    channelCount = 0;
+    for(int channel = 1; channel <= MAX_CHANNEL; ++channel) {
+      if(hasChannel(channel)) ++channelCount;
+    }
+  }
+}
+
+bool ChannelScheduler::setChannelsFromCountry(const uint8_t *countryIE, int length) {
+  //the country string (3 bytes), then triplets of first channel, number of channels and maximum power -
+  //unless the first is 201 or more, when it is an operating class rather than a channel
+  uint16_t countryChannels = 0;
+
+  for(int n = 3; n + 3 <= length; n += 3) {
+    int firstChannel = countryIE[n];
+    int numberOfChannels = countryIE[n + 1];
+
+    if(firstChannel > 0 && firstChannel <= MAX_CHANNEL) {
+      for(int channel = firstChannel; channel < firstChannel + numberOfChannels && channel <= MAX_CHANNEL; ++channel) {
+        countryChannels |= (1 << channel);
+      }
+    }
+  }
+
+  if(countryChannels) setChannels(countryChannels);
+
+  return(countryChannels != 0);
+}
+
+uint16_t ChannelScheduler::getChannels() {
+  return(channels);
+}
+
+bool ChannelScheduler::hasChannel(int channel) {
+  return(channel >= 1 && channel <= MAX_CHANNEL && (channels & (1 << channel)));
+}
+
+void ChannelScheduler::onFrame(int channel) {
+  if(channel >= 1 && channel <= MAX_CHANNEL) ++activity[channel].frames;
+}
+
+void ChannelScheduler::onDevice(int channel, eth_addr &macAddress, bool tracked) {
+  if(channel >= 1 && channel <= MAX_CHANNEL) {
+    ChannelActivity &a = activity[channel];
+
+    //distinct devices are counted approximately - a device that hashes to the bit of another is missed
+    uint8_t bit = (eth_addr_to_uint64(macAddress) * 0x9E3779B97F4A7C15ULL) >> 56;
+    uint32_t mask = 1UL << (bit & 31);
+    if(!(a.seenDevices[bit >> 5] & mask)) {
+      a.seenDevices[bit >> 5] |= mask;
+      ++a.devices;
+    }
+
+    if(tracked) ++a.trackedFrames;
+  }
+}
+
+int ChannelScheduler::loop(uint32_t nowMs) {
+  int result = 0;
+
+  if(currentChannel == 0 || !hasChannel(currentChannel)) {
+    result = nextChannel(0);
+    beginVisit(result, nowMs);
+  }
+  else if((uint32_t) (nowMs - dwellStartedAtMs) >= dwellMs) {
+    endVisit(nowMs);
+    result = nextChannel(currentChannel);
+    beginVisit(result, nowMs);
+  }
+
+  return(result);
+}
+
+int ChannelScheduler::getCurrentChannel() {
+  return(currentChannel);
+}
+
+void ChannelScheduler::beginVisit(int channel, uint32_t nowMs) {
+  ChannelActivity &a = activity[channel];
+
+  a.frames = 0;
+  a.devices = 0;
+  a.trackedFrames = 0;
+  memset(a.seenDevices, 0, sizeof(a.seenDevices));
+
+  //the exploration share is divided equally, the rest in proportion to each channel's score:
+  uint32_t cycleMs = (uint32_t) meanDwellMs * channelCount;
+  uint32_t minimumDwellMs = (cycleMs * explorationPercent) / (100 * channelCount);
+
+  uint32_t totalScore = 0;
+  for(int c = 1; c <= MAX_CHANNEL; ++c) {
+    if(hasChannel(c)) totalScore += activity[c].score;
+  }
+
+  if(totalScore == 0) dwellMs = meanDwellMs;
+  else dwellMs = minimumDwellMs + (uint32_t) (((uint64_t) (cycleMs - (minimumDwellMs * channelCount)) * a.score) / totalScore);
+
+  a.dwellMs = dwellMs;
+  currentChannel = channel;
+  dwellStartedAtMs = nowMs;
+}
+
+void ChannelScheduler::endVisit(uint32_t nowMs) {
+  ChannelActivity &a = activity[currentChannel];
+
+  uint32_t elapsedMs = max((uint32_t) (nowMs - dwellStartedAtMs), (uint32_t) 1);
+  uint32_t weighted = (a.frames * APPROXIMATE_CHANNEL_FRAME_WEIGHT) + (a.devices * APPROXIMATE_CHANNEL_DEVICE_WEIGHT) + (a.trackedFrames * APPROXIMATE_CHANNEL_TRACKED_WEIGHT);
+  uint32_t rate = (uint32_t) (((uint64_t) weighted * 1000) / elapsedMs);
+
+  //smoothed over visits, but not so much that a channel that has gone quiet keeps its share for long:
+  a.score = (a.score + rate + 1) / 2;
+}
+
+int ChannelScheduler::nextChannel(int channel) {
+  int next = channel;
+
+  for(int n = 0; n < MAX_CHANNEL; ++n) {
+    next = (next % MAX_CHANNEL) + 1;
+    if(hasChannel(next)) break;
+  }
+
+  return(next);
+}
+
+int ChannelScheduler::getDwellMs(int channel) {
+  return((channel >= 1 && channel <= MAX_CHANNEL) ? activity[channel].dwellMs : 0);
+}
+
+uint32_t ChannelScheduler::getScore(int channel) {
+  return((channel >= 1 && channel <= MAX_CHANNEL) ? activity[channel].score : 0);
+}
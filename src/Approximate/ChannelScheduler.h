@@ -0,0 +1,89 @@
+/*
+    ChannelScheduler.h
+    Approximate Library
+    -
+    Decides how long the sniffer stays on each channel while it scans. Every
+    channel in the set is visited once per cycle, in order, but the time
+    spent on each is in proportion to the activity seen there on previous
+    visits - frames, distinct devices and frames from tracked devices, as a
+    rate - after a minimum share of the cycle that is divided equally, so
+    that quiet channels are still explored. The channel set defaults to 1 to
+    13, or is taken from the first-channel/number-of-channels triplets of a
+    Country IE.
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#ifndef ChannelScheduler_h
+#define ChannelScheduler_h
+
+#include <Arduino.h>
+#include "eth_addr.h"
+
+//the weights of each kind of activity in a channel's score
+#ifndef APPROXIMATE_CHANNEL_FRAME_WEIGHT
+  #define APPROXIMATE_CHANNEL_FRAME_WEIGHT 1
+#endif
+#ifndef APPROXIMATE_CHANNEL_DEVICE_WEIGHT
+  #define APPROXIMATE_CHANNEL_DEVICE_WEIGHT 16
+#endif
+#ifndef APPROXIMATE_CHANNEL_TRACKED_WEIGHT
+  #define APPROXIMATE_CHANNEL_TRACKED_WEIGHT 4
+#endif
+
+class ChannelScheduler {
+  public:
+    static const int MAX_CHANNEL = 14;
+
+  private:
+    typedef struct {
+      //counted during the current visit - by the radio's callback, so kept simple:
+      volatile uint16_t frames;
+      volatile uint16_t devices;
+      volatile uint16_t trackedFrames;
+      uint32_t seenDevices[8];        //a 256 bit hash of the devices seen this visit
+
+      uint32_t score;                 //activity per second, smoothed over visits
+      uint16_t dwellMs;               //of the last visit
+    } ChannelActivity;
+
+    ChannelActivity activity[MAX_CHANNEL + 1];
+    uint16_t channels = 0;            //bit n set if channel n is in the set
+    int channelCount = 0;
+
+    int meanDwellMs = 1000;
+    int explorationPercent = 20;
+
+    int currentChannel = 0;
+    uint32_t dwellStartedAtMs = 0;
+    uint32_t dwellMs = 0;
+
+    void beginVisit(int channel, uint32_t nowMs);
+    void endVisit(uint32_t nowMs);
+    int nextChannel(int channel);
+
+  public:
+    ChannelScheduler();
+
+    //meanDwellMs is the cycle length divided by the number of channels; explorationPercent of the cycle is divided equally -
+    //at 100 every channel is given the same time, as a simple round-robin
+    void init(int meanDwellMs = 1000, int explorationPercent = 20);
+
+    void setChannels(uint16_t channels);
+    bool setChannelsFromCountry(const uint8_t *countryIE, int length);
+    uint16_t getChannels();
+    bool hasChannel(int channel);
+
+    void onFrame(int channel);
+    void onDevice(int channel, eth_addr &macAddress, bool tracked);
+
+    //the channel to change to, if it is time to - otherwise 0
+    int loop(uint32_t nowMs);
+    int getCurrentChannel();
+
+    int getDwellMs(int channel);      //of its last visit
+    uint32_t getScore(int channel);
+};
+
+#endif
@@ -0,0 +1,138 @@
+/*
+    ChannelStream.cpp
+    Approximate Library
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include "ChannelStream.h"
+
+uint16_t ChannelStream::crc16(const uint8_t *data, size_t length) {
+  uint16_t crc = 0xFFFF;
+
+  for(size_t n = 0; n < length; ++n) {
+    crc ^= (uint16_t) data[n] << 8;
+    for(int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+    }
+  }
+
+  return(crc);
+}
+
+size_t ChannelStreamWriter::encode(Channel *channel, uint8_t *out) {
+  eth_addr source;
+  channel -> getBssid(source);
+  uint32_t timestampUs = channel -> getTimestampUs();
+
+  out[0] = ChannelStream::SYNC_0;
+  out[1] = ChannelStream::SYNC_1;
+  out[2] = ChannelStream::VERSION;
+  out[3] = sequence & 0xFF;
+  out[4] = sequence >> 8;
+  for(int n = 0; n < 4; ++n) out[5 + n] = (timestampUs >> (n * 8)) & 0xFF;
+  memcpy(out + 9, source.addr, 6);
+  out[15] = (uint8_t) (int8_t) channel -> getRSSI();
+  out[16] = (uint8_t) channel -> getChannel();
+  out[17] = ChannelStream::BUFFER_SIZE;
+  memcpy(out + 18, channel -> getBuffer(), ChannelStream::BUFFER_SIZE);
+
+  uint16_t crc = ChannelStream::crc16(out + 2, ChannelStream::FRAME_SIZE - 4);
+  out[ChannelStream::FRAME_SIZE - 2] = crc & 0xFF;
+  out[ChannelStream::FRAME_SIZE - 1] = crc >> 8;
+
+  ++sequence;
+
+  return(ChannelStream::FRAME_SIZE);
+}
+
+size_t ChannelStreamWriter::write(Channel *channel, Print &out) {
+  uint8_t frame[ChannelStream::FRAME_SIZE];
+  encode(channel, frame);
+
+  return(out.write(frame, ChannelStream::FRAME_SIZE));
+}
+
+uint16_t ChannelStreamWriter::getSequence() {
+  return(sequence);
+}
+
+bool ChannelStreamReader::read(uint8_t b, Channel &channel) {
+  bool result = false;
+
+  frame[length++] = b;
+  ++offset;
+
+  if(length == 1 && frame[0] != ChannelStream::SYNC_0) resync(1);
+  else if(length == 2 && frame[1] != ChannelStream::SYNC_1) resync(1);
+  else if(length == 3 && frame[2] != ChannelStream::VERSION) resync(1);
+  else if(length == 18 && frame[17] != ChannelStream::BUFFER_SIZE) resync(1);
+  else if(length == ChannelStream::FRAME_SIZE) {
+    uint16_t crc = frame[ChannelStream::FRAME_SIZE - 2] | (frame[ChannelStream::FRAME_SIZE - 1] << 8);
+
+    unsigned long frameAt = offset - ChannelStream::FRAME_SIZE;
+
+    if(crc == ChannelStream::crc16(frame + 2, ChannelStream::FRAME_SIZE - 4)) {
+      uint16_t thisSequence = frame[3] | (frame[4] << 8);
+      if(hasSequence) droppedCount += (uint16_t) (thisSequence - sequence - 1);
+      sequence = thisSequence;
+      hasSequence = true;
+
+      eth_addr source;
+      memcpy(source.addr, frame + 9, 6);
+
+      channel.setBssid(source);
+      channel.setTimestampUs((uint32_t) frame[5] | ((uint32_t) frame[6] << 8) | ((uint32_t) frame[7] << 16) | ((uint32_t) frame[8] << 24));
+      channel.setRSSI((int8_t) frame[15]);
+      channel.setChannel(frame[16]);
+      channel.setBuffer((int8_t *) (frame + 18));
+
+      ++frameCount;
+      expectedAt = offset;
+      length = 0;
+      result = true;
+    }
+    else {
+      //only where a frame was expected is this one corrupt - elsewhere the sync word may just have been data
+      if(hasSequence && frameAt == expectedAt) {
+        ++corruptCount;
+        expectedAt += ChannelStream::FRAME_SIZE;
+      }
+      //either way look again for a frame starting after it
+      resync(1);
+    }
+  }
+
+  return(result);
+}
+
+void ChannelStreamReader::resync(int from) {
+  //drop bytes until the next possible start of a frame
+  int start = from;
+  while(start < length && !(frame[start] == ChannelStream::SYNC_0 && (start + 1 == length || frame[start + 1] == ChannelStream::SYNC_1))) ++start;
+
+  skippedBytes += start;
+  length -= start;
+  memmove(frame, frame + start, length);
+}
+
+uint16_t ChannelStreamReader::getSequence() {
+  return(sequence);
+}
+
+unsigned long ChannelStreamReader::getFrameCount() {
+  return(frameCount);
+}
+
+unsigned long ChannelStreamReader::getCorruptCount() {
+  return(corruptCount);
+}
+
+unsigned long ChannelStreamReader::getDroppedCount() {
+  return(droppedCount);
+}
+
+unsigned long ChannelStreamReader::getSkippedBytes() {
+  return(skippedBytes);
+}
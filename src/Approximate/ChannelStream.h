@@ -0,0 +1,88 @@
+/*
+    ChannelStream.h
+    Approximate Library
+    -
+    A framed binary encoding of channel state information (CSI), for streaming
+    from the ChannelStateHandler over a fast serial link rather than as text.
+    Each frame is FRAME_SIZE bytes, multi-byte fields little-endian:
+
+      0   sync word        0xA5 0x5A
+      2   version          VERSION
+      3   sequence         uint16, one more than the last frame written
+      5   timestamp        uint32, microseconds on the radio's clock
+      9   source           6 byte MAC address (the BSSID)
+      15  rssi             int8
+      16  channel          uint8
+      17  length           uint8, of the buffer (always 128)
+      18  buffer           128 x int8, as Channel::getBufferN()
+      146 crc              uint16, CRC-16/CCITT-FALSE of bytes 2 to 145
+
+    ChannelStreamWriter encodes frames; ChannelStreamReader finds them again in
+    a stream of bytes - skipping whatever else is written to the same port -
+    and counts the frames that were corrupted, or dropped (from the gaps in
+    their sequence numbers).
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#ifndef ChannelStream_h
+#define ChannelStream_h
+
+#include <Arduino.h>
+#include "eth_addr.h"
+
+#include "Channel.h"
+
+class ChannelStream {
+  public:
+    static const uint8_t SYNC_0 = 0xA5;
+    static const uint8_t SYNC_1 = 0x5A;
+    static const uint8_t VERSION = 1;
+    static const int BUFFER_SIZE = 128;
+    static const int FRAME_SIZE = 18 + BUFFER_SIZE + 2;
+
+    static uint16_t crc16(const uint8_t *data, size_t length);
+};
+
+class ChannelStreamWriter {
+  private:
+    uint16_t sequence = 0;
+
+  public:
+    size_t encode(Channel *channel, uint8_t *out);   //out of at least ChannelStream::FRAME_SIZE bytes
+    size_t write(Channel *channel, Print &out);
+
+    uint16_t getSequence();   //of the next frame
+};
+
+class ChannelStreamReader {
+  private:
+    uint8_t frame[ChannelStream::FRAME_SIZE];
+    int length = 0;
+
+    bool hasSequence = false;
+    uint16_t sequence = 0;
+
+    unsigned long offset = 0;               //bytes read
+    unsigned long expectedAt = 0;           //the offset of the next frame, once a frame has been read
+
+    unsigned long frameCount = 0;
+    unsigned long corruptCount = 0;
+    unsigned long droppedCount = 0;
+    unsigned long skippedBytes = 0;
+
+    void resync(int from);
+
+  public:
+    //true when the byte completes a frame, which is then decoded into channel
+    bool read(uint8_t b, Channel &channel);
+
+    uint16_t getSequence();                 //of the last frame read
+    unsigned long getFrameCount();
+    unsigned long getCorruptCount();        //frames that failed their CRC
+    unsigned long getDroppedCount();        //frames missing between those read, corrupt or lost
+    unsigned long getSkippedBytes();        //not part of any good frame
+};
+
+#endif
@@ -0,0 +1,132 @@
+/*
+    CrowdCounter.cpp
+    Approximate Library
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include "CrowdCounter.h"
+
+#define CROWD_INTERVAL_BYTES (APPROXIMATE_CROWD_REGISTERS / 2)
+
+CrowdCounter::~CrowdCounter() {
+  delete[] registers;
+}
+
+bool CrowdCounter::init(uint32_t windowMs, uint32_t nowMs) {
+  bool success = false;
+
+  if(windowMs >= APPROXIMATE_CROWD_INTERVALS) {
+    if(!registers) registers = new uint8_t[APPROXIMATE_CROWD_INTERVALS * CROWD_INTERVAL_BYTES];
+    intervalMs = windowMs / APPROXIMATE_CROWD_INTERVALS;
+    clear(nowMs);
+
+    success = true;
+  }
+
+  return(success);
+}
+
+bool CrowdCounter::isInitialised() {
+  return(registers != NULL);
+}
+
+void CrowdCounter::clear(uint32_t nowMs) {
+  if(registers) memset(registers, 0, APPROXIMATE_CROWD_INTERVALS * CROWD_INTERVAL_BYTES);
+  currentInterval = 0;
+  intervalStartedAtMs = clearedAtMs = nowMs;
+}
+
+void CrowdCounter::advance(uint32_t atMs) {
+  uint32_t elapsedMs = atMs - intervalStartedAtMs;
+
+  //a time from a moment before - a frame queued before the interval changed - is counted in the current one
+  if((int32_t) elapsedMs > 0 && elapsedMs >= intervalMs) {
+    uint32_t intervals = elapsedMs / intervalMs;
+    if(intervals >= APPROXIMATE_CROWD_INTERVALS) {
+      //nothing seen is still in the window
+      clear(atMs - (elapsedMs % intervalMs));
+    }
+    else {
+      for(uint32_t n = 0; n < intervals; ++n) {
+        currentInterval = (currentInterval + 1) % APPROXIMATE_CROWD_INTERVALS;
+        memset(registers + currentInterval * CROWD_INTERVAL_BYTES, 0, CROWD_INTERVAL_BYTES);
+      }
+      intervalStartedAtMs += intervals * intervalMs;
+    }
+  }
+}
+
+void CrowdCounter::add(uint64_t hash, uint32_t atMs) {
+  if(registers) {
+    advance(atMs);
+
+    //the top bits choose the register, the run of leading zeros that follows is the rank
+    uint32_t r = hash >> (64 - __builtin_ctz(APPROXIMATE_CROWD_REGISTERS));
+    uint64_t rest = hash << __builtin_ctz(APPROXIMATE_CROWD_REGISTERS);
+    uint8_t rank = rest ? min(__builtin_clzll(rest) + 1, (int) MAX_RANK) : MAX_RANK;
+
+    uint8_t &pair = registers[currentInterval * CROWD_INTERVAL_BYTES + r / 2];
+    uint8_t shift = (r & 1) ? 4 : 0;
+    if(rank > ((pair >> shift) & 0xF)) pair = (pair & ~(0xF << shift)) | (rank << shift);
+  }
+}
+
+uint32_t CrowdCounter::getEstimate(uint32_t atMs) {
+  uint32_t estimate = 0;
+
+  if(registers) {
+    advance(atMs);
+
+    //the registers of every interval merged, by their maximum
+    float sum = 0;
+    int zeros = 0;
+    for(int r = 0; r < APPROXIMATE_CROWD_REGISTERS; ++r) {
+      uint8_t rank = 0;
+      for(int interval = 0; interval < APPROXIMATE_CROWD_INTERVALS; ++interval) {
+        uint8_t pair = registers[interval * CROWD_INTERVAL_BYTES + r / 2];
+        rank = max(rank, (uint8_t) ((r & 1) ? (pair >> 4) : (pair & 0xF)));
+      }
+      sum += 1.0f / (1UL << rank);
+      if(rank == 0) ++zeros;
+    }
+
+    const float m = APPROXIMATE_CROWD_REGISTERS;
+    float e = (0.7213f / (1.0f + 1.079f / m)) * m * m / sum;
+    //a few devices leave most registers empty, so are better counted by how many are
+    if(e <= 2.5f * m && zeros > 0) e = m * logf(m / zeros);
+
+    estimate = (uint32_t) (e + 0.5f);
+  }
+
+  return(estimate);
+}
+
+uint32_t CrowdCounter::getSpanMs(uint32_t atMs) {
+  uint32_t spanMs = 0;
+
+  if(registers) {
+    advance(atMs);
+    //no more than the time since the counter was last empty
+    spanMs = min(atMs - intervalStartedAtMs + (APPROXIMATE_CROWD_INTERVALS - 1) * intervalMs, atMs - clearedAtMs);
+  }
+
+  return(spanMs);
+}
+
+uint32_t CrowdCounter::getWindowMs() {
+  return(intervalMs * APPROXIMATE_CROWD_INTERVALS);
+}
+
+size_t CrowdCounter::getSizeBytes() {
+  return(APPROXIMATE_CROWD_INTERVALS * CROWD_INTERVAL_BYTES);
+}
+
+uint64_t CrowdCounter::hash(eth_addr &macAddress) {
+  //the finaliser of splitmix64 - every bit of the address reaches every bit of the hash
+  uint64_t h = eth_addr_to_uint64(macAddress);
+  h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+  return(h ^ (h >> 31));
+}
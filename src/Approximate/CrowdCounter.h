@@ -0,0 +1,73 @@
+/*
+    CrowdCounter.h
+    Approximate Library
+    -
+    An estimate of how many distinct devices have been seen over a sliding
+    window of time, in fixed memory however many there are - a HyperLogLog
+    sketch. Each device's MAC address is hashed: the top bits choose one of
+    APPROXIMATE_CROWD_REGISTERS registers, which keeps the longest run of
+    leading zeros seen in the rest, so the registers together say roughly how
+    many distinct hashes have been added. The standard error is about
+    1.04 / sqrt(APPROXIMATE_CROWD_REGISTERS): 9% on the ESP8266 and 6.5% on
+    the ESP32. Runs are capped at 15, so each register is four bits.
+    To slide, the window is split into APPROXIMATE_CROWD_INTERVALS intervals,
+    each with its own registers; the oldest is cleared as each new interval
+    begins, and an estimate merges them all. So the window covered is the
+    current interval and the complete ones before it - between (n - 1) / n of
+    the window and all of it. Times are compared by their difference, so the
+    window keeps sliding when millis() wraps after 49 days.
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#ifndef CrowdCounter_h
+#define CrowdCounter_h
+
+#include <Arduino.h>
+#include "eth_addr.h"
+
+#ifndef APPROXIMATE_CROWD_REGISTERS
+  #if defined(ESP8266)
+    #define APPROXIMATE_CROWD_REGISTERS 128   //must be a power of two, at least 16
+  #else
+    #define APPROXIMATE_CROWD_REGISTERS 256
+  #endif
+#endif
+
+#ifndef APPROXIMATE_CROWD_INTERVALS
+  #define APPROXIMATE_CROWD_INTERVALS 8       //of each window
+#endif
+
+class CrowdCounter {
+  private:
+    static const uint8_t MAX_RANK = 15;
+
+    uint8_t *registers = NULL;      //two to a byte, APPROXIMATE_CROWD_REGISTERS for each interval in turn
+    uint32_t intervalMs = 0;
+    uint32_t intervalStartedAtMs = 0;
+    uint32_t clearedAtMs = 0;
+    uint8_t currentInterval = 0;
+
+    void advance(uint32_t atMs);    //to the interval atMs is in, clearing those it has passed
+
+  public:
+    ~CrowdCounter();
+
+    //allocating only the first time; always empties the counter
+    bool init(uint32_t windowMs, uint32_t nowMs);
+    bool isInitialised();
+    void clear(uint32_t nowMs);
+
+    //the same hash for the same device - see hash()
+    void add(uint64_t hash, uint32_t atMs);
+    uint32_t getEstimate(uint32_t atMs);
+    uint32_t getSpanMs(uint32_t atMs);   //the time an estimate at atMs covers - to the start of the oldest interval
+
+    uint32_t getWindowMs();
+    static size_t getSizeBytes();
+
+    static uint64_t hash(eth_addr &macAddress);
+};
+
+#endif
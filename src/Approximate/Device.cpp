@@ -17,6 +17,11 @@ Device::Device() {
 Device::Device(Device *b) {
     init(b -> macAddress, b -> bssid, b -> channel, b -> rssi, b -> lastSeenAtMs, b -> dataFlowBytes, b -> ipAddress.addr);
     setSSID(b -> ssid);
+    setProbeFingerprint(b -> probeFingerprint);
+
+    rssiEstimator = b -> rssiEstimator;
+    proximate = b -> proximate;
+    trafficSummary = b -> trafficSummary;
 }
 
 Device::Device(eth_addr &macAddress, eth_addr &bssid, int channel, int rssi, long lastSeenAtMs, int dataFlowBytes, u32_t ipAddress) {
@@ -48,12 +53,14 @@ void Device::init(eth_addr &macAddress, eth_addr &bssid, int channel, int rssi,
     setIPAddress(ipAddress);
 
     ssid[0] = '\0';
+    probeFingerprint = 0;
 }
 
 void Device::update(Device *d) {
     if(d) {
         init(d -> macAddress, d -> bssid, d -> channel, d -> rssi, d -> lastSeenAtMs, d -> dataFlowBytes, d -> ipAddress.addr);
         setSSID(d -> ssid);
+        setProbeFingerprint(d -> probeFingerprint);
     }
 }
 
@@ -124,6 +131,25 @@ void Device::setSSID(const char *ssid) {
     }
 }
 
+void Device::setSSID(const char *ssid, int length) {
+    if(ssid && length > 0) {
+        length = min(length, 32);
+        memcpy(this->ssid, ssid, length);
+        this->ssid[length] = '\0';
+    }
+    else {
+        this->ssid[0] = '\0';
+    }
+}
+
+void Device::setProbeFingerprint(uint64_t probeFingerprint) {
+    this->probeFingerprint = probeFingerprint;
+}
+
+uint64_t Device::getProbeFingerprint() {
+    return(probeFingerprint);
+}
+
 String Device::getSSIDAsString() {
     return String(ssid);
 }
@@ -145,6 +171,30 @@ int Device::getRSSI(bool uploadOnly) {
     return(rssi);
 }
 
+void Device::resetRSSIEstimate(RSSIEstimator::Type type, int priorRSSI) {
+    rssiEstimator.reset(type, priorRSSI);
+}
+
+int Device::updateRSSIEstimate(RSSIEstimator::Type type, int rssi) {
+    return(rssiEstimator.update(type, rssi));
+}
+
+int Device::getRSSIEstimate() {
+    return(rssiEstimator.get());
+}
+
+void Device::setProximate(bool proximate) {
+    this -> proximate = proximate;
+}
+
+bool Device::isProximate() {
+    return(proximate);
+}
+
+TrafficSummary *Device::getTrafficSummary() {
+    return(&trafficSummary);
+}
+
 void Device::setLastSeenAtMs(long lastSeenAtMs) {
     if(lastSeenAtMs == -1) lastSeenAtMs = millis(); 
     this -> lastSeenAtMs = lastSeenAtMs;
@@ -158,12 +208,19 @@ void Device::setTimeOutAtMs(long timeOutAtMs) {
     this -> timeOutAtMs = timeOutAtMs;
 }
 
+long Device::getTimeOutAtMs() {
+    return(timeOutAtMs);
+}
+
 void Device::setReducedTimeOutAtMs(long timeOutAtMs) {
-    setTimeOutAtMs(min(timeOutAtMs, this -> timeOutAtMs));
+    //compared by difference, so this still holds when millis() wraps
+    if(this -> timeOutAtMs == -1 || (int32_t) ((uint32_t) timeOutAtMs - (uint32_t) this -> timeOutAtMs) < 0) {
+        setTimeOutAtMs(timeOutAtMs);
+    }
 }
 
 bool Device::hasTimedOut() {
-    return(millis() > timeOutAtMs || timeOutAtMs == -1);
+    return(timeOutAtMs == -1 || (int32_t) ((uint32_t) millis() - (uint32_t) timeOutAtMs) > 0);
 }
 
 bool Device::matches(eth_addr &macAddress) {
@@ -218,9 +275,9 @@ bool Device::isIndividual() {
 //Universal/local and individual/group defined by: https://standards.ieee.org/content/dam/ieee-standards/standards/web/documents/tutorials/macgrp.pdf
 
 bool Device::isLocal() {
-    return((macAddress.addr[0] & 0x2 == 0x2) && !isGroup());
+    return(((macAddress.addr[0] & 0x2) == 0x2) && !isGroup());
 }
 
 bool Device::isGroup() {
-    return(macAddress.addr[0] & 0x1 == 0x1);
+    return((macAddress.addr[0] & 0x1) == 0x1);
 }
\ No newline at end of file
@@ -12,11 +12,16 @@
 
 #include <Arduino.h>
 #include "Network.h"
+#include "RSSIEstimator.h"
+#include "TrafficSummary.h"
 #include "eth_addr.h"
 
 #define APPROXIMATE_UNKNOWN_RSSI 0
 
+//A device as a handler sees it - the tables keep a DeviceRecord, loaded into a Device for each call
 class Device : public Network {
+    friend class DeviceTable;
+
     private:
         eth_addr macAddress = {{0,0,0,0,0,0}};
         ip4_addr_t ipAddress;
@@ -24,9 +29,15 @@ class Device : public Network {
         long lastSeenAtMs = -1;
         int dataFlowBytes = 0;  //uploading is negative, downloading positive
         char ssid[33] = {0};
+        uint64_t probeFingerprint = 0;      //of the probe request it was seen in - see InfoElements
 
         long timeOutAtMs = -1;
 
+        RSSIEstimator rssiEstimator;
+        bool proximate = false;             //has arrived, rather than only being a candidate to
+
+        TrafficSummary trafficSummary;      //data frames since the start of the window - see Approximate::setTrafficSummaryWindowMs()
+
     public:
         Device();
         Device(Device *b);
@@ -53,16 +64,31 @@ class Device : public Network {
         bool hasIPAddress();
 
         void setSSID(const char *ssid);
+        void setSSID(const char *ssid, int length);    //not NUL-terminated - as an SSID element's data
         String getSSIDAsString();
         bool hasSSID();
 
+        //the same for each probe request a device sends, whatever its MAC address - 0 if it has not been seen probing
+        void setProbeFingerprint(uint64_t probeFingerprint);
+        uint64_t getProbeFingerprint();
+
         void setRSSI(int rssi);
         int getRSSI(bool uploadOnly = true);
 
+        void resetRSSIEstimate(RSSIEstimator::Type type, int priorRSSI);
+        int updateRSSIEstimate(RSSIEstimator::Type type, int rssi);
+        int getRSSIEstimate();
+
+        void setProximate(bool proximate);
+        bool isProximate();
+
+        TrafficSummary *getTrafficSummary();
+
         void setLastSeenAtMs(long lastSeenAtMs = -1);
         int getLastSeenAtMs();
 
         void setTimeOutAtMs(long timeOutAtMs);
+        long getTimeOutAtMs();
         void setReducedTimeOutAtMs(long timeOutAtMs);
         bool hasTimedOut();
 
@@ -0,0 +1,104 @@
+/*
+    DeviceRecord.cpp
+    Approximate Library
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include "DeviceRecord.h"
+
+void DeviceRecord::getMacAddress(eth_addr &macAddress) {
+  memcpy(macAddress.addr, this -> macAddress, 6);
+}
+
+bool DeviceRecord::matches(const uint8_t *macAddress) {
+  return(memcmp(this -> macAddress, macAddress, 6) == 0);
+}
+
+void DeviceRecord::getIPAddress(ip4_addr_t &ipAddress) {
+  ipAddress.addr = this -> ipAddress;
+}
+
+bool DeviceRecord::hasIPAddress() {
+  return(ipAddress != IPADDR_ANY);
+}
+
+void DeviceRecord::resetRSSIEstimate(RSSIEstimator::Type type, int priorRSSI) {
+  rssiEstimator.reset(type, priorRSSI);
+}
+
+int DeviceRecord::updateRSSIEstimate(RSSIEstimator::Type type, int rssi) {
+  return(rssiEstimator.update(type, rssi));
+}
+
+int DeviceRecord::getRSSIEstimate() {
+  return(rssiEstimator.get());
+}
+
+void DeviceRecord::setProximate(bool proximate) {
+  if(proximate != isProximate()) changed = 1;
+
+  if(proximate) flags |= PROXIMATE;
+  else flags &= ~PROXIMATE;
+}
+
+bool DeviceRecord::isProximate() {
+  return(flags & PROXIMATE);
+}
+
+void DeviceRecord::setEvicted() {
+  flags |= EVICTED;
+}
+
+bool DeviceRecord::isEvicted() {
+  return(flags & EVICTED);
+}
+
+int DeviceRecord::getChannel() {
+  return(channel);
+}
+
+bool DeviceRecord::isRepeatedFrame(bool toDevice, uint16_t sequenceControl, bool retry) {
+  bool repeated = false;
+
+  uint8_t seen = toDevice ? SEQUENCE_TO_DEVICE : SEQUENCE_FROM_DEVICE;
+  uint16_t &last = this -> sequenceControl[toDevice ? 1 : 0];
+
+  if(retry && (flags & seen)) {
+    //only a frame marked as a retransmission, of exactly the last - a receiver keeps a cache for each traffic identifier
+    //(TID), and one for management frames, but a record has room for one field each way, shared by them all; a repeat
+    //of an earlier frame, or of one on another TID, is passed on rather than risk dropping a frame never seen
+    repeated = (sequenceControl == last);
+  }
+
+  if(!repeated) {
+    last = sequenceControl;
+    flags |= seen;
+  }
+
+  return(repeated);
+}
+
+void DeviceRecord::setChanged() {
+  changed = 1;
+}
+
+bool DeviceRecord::takeChanged() {
+  #if defined(ESP8266)
+    //single core - the radio callback does not interrupt loop()
+    bool result = changed;
+    changed = 0;
+    return(result);
+  #else
+    return(__atomic_exchange_n(&changed, 0, __ATOMIC_RELAXED));
+  #endif
+}
+
+long DeviceRecord::getLastSeenAtMs() {
+  //the ticks since it was last seen, counted back from the start of the current tick
+  uint32_t nowTick = millis() >> LAST_SEEN_TICK_SHIFT;
+  uint16_t ticksAgo = (uint16_t) nowTick - lastSeenTick;
+
+  return((long) ((nowTick - ticksAgo) << LAST_SEEN_TICK_SHIFT));
+}
@@ -0,0 +1,80 @@
+/*
+    DeviceRecord.h
+    Approximate Library
+    -
+    What a DeviceTable keeps of each device, packed so that thousands can be
+    tracked: the MAC address as the key, the RSSI and channel in a byte each,
+    the time last seen as a 16-bit count of ticks (so only meaningful within
+    about two hours - much longer than any time out) and the SSID as a handle
+    into a StringPool shared by every table. The sequence control field of the
+    last frame from the device, and to it, is kept so that retransmissions can
+    be recognised. Handlers never see a record - the table loads one into a
+    Device for them (see DeviceTable::load()).
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#ifndef DeviceRecord_h
+#define DeviceRecord_h
+
+#include <Arduino.h>
+#include "eth_addr.h"
+
+#include "RSSIEstimator.h"
+
+class DeviceRecord {
+  friend class DeviceTable;
+
+  public:
+    static const int LAST_SEEN_TICK_SHIFT = 7;   //each tick is 2^7 = 128ms
+
+  private:
+    static const uint8_t PROXIMATE = 0x01;
+    static const uint8_t SEQUENCE_FROM_DEVICE = 0x02;   //sequenceControl[0] is set
+    static const uint8_t SEQUENCE_TO_DEVICE = 0x04;     //sequenceControl[1] is set
+    static const uint8_t EVICTED = 0x08;                //to depart from loop(), making room for another device
+
+    uint32_t ipAddress;
+    uint8_t macAddress[6];
+    uint8_t bssid[6];
+    RSSIEstimator rssiEstimator;
+    uint16_t lastSeenTick;
+    uint16_t ssid;                    //a StringPool handle
+    int16_t dataFlowBytes;            //as Device, saturated
+    uint16_t sequenceControl[2];      //of the last frame from the device, and from the access point to it
+    uint8_t channel;
+    int8_t rssi;
+    uint8_t flags;
+    volatile uint8_t changed;         //since it was last written to a DeviceStore - only its IP address, SSID or proximity count
+
+  public:
+    void getMacAddress(eth_addr &macAddress);
+    bool matches(const uint8_t *macAddress);
+
+    void getIPAddress(ip4_addr_t &ipAddress);
+    bool hasIPAddress();
+
+    void resetRSSIEstimate(RSSIEstimator::Type type, int priorRSSI);
+    int updateRSSIEstimate(RSSIEstimator::Type type, int rssi);
+    int getRSSIEstimate();
+
+    void setProximate(bool proximate);
+    bool isProximate();
+
+    void setEvicted();
+    bool isEvicted();
+
+    int getChannel();
+
+    //whether a retransmitted frame from the device - or, toDevice, from the access point to it - repeats the last frame
+    //seen from that transmitter, judged by its sequence control field; if it does not, it is the last seen
+    bool isRepeatedFrame(bool toDevice, uint16_t sequenceControl, bool retry);
+
+    void setChanged();
+    bool takeChanged();               //whether it had changed, marking it as not
+
+    long getLastSeenAtMs();
+};
+
+#endif
@@ -0,0 +1,239 @@
+/*
+    DeviceStore.cpp
+    Approximate Library
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include "DeviceStore.h"
+
+bool DeviceStore::begin(const char *path) {
+  if(path && strlen(path) < sizeof(this -> path)) {
+    #if defined(APPROXIMATE_NATIVE)
+      open = true;
+    #else
+      //never formatted - the filesystem may hold the application's own files, so if it cannot be mounted there is no store
+      open = LittleFS.begin();
+    #endif
+
+    if(open) {
+      strcpy(this -> path, path);
+      snprintf(compactionPath, sizeof(compactionPath), "%s.new", path);
+      bufferCount = 0;
+      entryCount = 0;
+    }
+  }
+
+  return(open);
+}
+
+void DeviceStore::end() {
+  flush();
+  open = false;
+}
+
+bool DeviceStore::isOpen() {
+  return(open);
+}
+
+uint16_t DeviceStore::checksum(Entry &entry) {
+  uint16_t a = 0, b = 0;
+
+  uint8_t *bytes = (uint8_t *) &entry;
+  for(size_t n = 0; n < offsetof(Entry, check); ++n) {
+    a = (a + bytes[n]) % 255;
+    b = (b + a) % 255;
+  }
+
+  return((b << 8) | a);
+}
+
+bool DeviceStore::isValid(Entry &entry) {
+  //a checksum only shows the entry was written whole - not by this version, nor that what was written made sense
+  return(entry.version == VERSION && entry.type >= DEVICE && entry.type <= HOST && entry.ssidLength <= sizeof(entry.ssid));
+}
+
+int DeviceStore::load(EntryHandler entryHandler) {
+  int count = 0;
+
+  if(open) {
+    Entry entry;
+
+    #if defined(APPROXIMATE_NATIVE)
+      //a compaction that was not completed leaves the new file, and perhaps no log:
+      FILE *file = fopen(path, "rb");
+      if(!file && (file = fopen(compactionPath, "rb")) != NULL) {
+        fclose(file);
+        rename(compactionPath, path);
+        file = fopen(path, "rb");
+      }
+
+      if(file) {
+        size_t length;
+        while((length = fread(&entry, 1, sizeof(entry), file)) > 0) {
+          if(length < sizeof(entry) || entry.check != checksum(entry)) {
+            torn = true;
+            break;
+          }
+          if(isValid(entry)) {
+            entryHandler(entry);
+            ++count;
+          }
+        }
+        fclose(file);
+      }
+    #else
+      if(!LittleFS.exists(path) && LittleFS.exists(compactionPath)) LittleFS.rename(compactionPath, path);
+
+      File file = LittleFS.open(path, "r");
+      if(file) {
+        int length;
+        while((length = file.read((uint8_t *) &entry, sizeof(entry))) > 0) {
+          if(length < (int) sizeof(entry) || entry.check != checksum(entry)) {
+            torn = true;
+            break;
+          }
+          if(isValid(entry)) {
+            entryHandler(entry);
+            ++count;
+          }
+        }
+        file.close();
+      }
+    #endif
+  }
+
+  entryCount = loadedCount = count;
+
+  return(count);
+}
+
+void DeviceStore::toEntry(Entry &entry, EntryType type, eth_addr &macAddress, uint32_t ipAddress, int channel, const char *ssid) {
+  memset(&entry, 0, sizeof(entry));
+
+  entry.type = type;
+  entry.version = VERSION;
+  memcpy(entry.macAddress, macAddress.addr, 6);
+  entry.ipAddress = ipAddress;
+  entry.channel = (channel > 0 && channel < 0xFF) ? channel : 0;
+  if(ssid) {
+    entry.ssidLength = strnlen(ssid, sizeof(entry.ssid));
+    memcpy(entry.ssid, ssid, entry.ssidLength);
+  }
+}
+
+void DeviceStore::append(Entry &entry) {
+  if(open) {
+    if(bufferCount == APPROXIMATE_STORE_BUFFER_ENTRIES) flush();
+
+    entry.check = checksum(entry);
+    buffer[bufferCount++] = entry;
+  }
+}
+
+bool DeviceStore::write(const char *path, const char *mode, Entry *entries, int count) {
+  bool success = false;
+
+  #if defined(APPROXIMATE_NATIVE)
+    FILE *file = fopen(path, mode);
+    if(file) {
+      success = (fwrite(entries, sizeof(Entry), count, file) == (size_t) count);
+      fclose(file);
+    }
+  #else
+    File file = LittleFS.open(path, mode);
+    if(file) {
+      success = (file.write((uint8_t *) entries, sizeof(Entry) * count) == sizeof(Entry) * count);
+      file.close();
+    }
+  #endif
+
+  return(success);
+}
+
+bool DeviceStore::flush() {
+  bool success = true;
+
+  if(open && bufferCount > 0) {
+    //a torn entry at the end of the log would hide any appended after it - so it is compacted first
+    success = !torn && write(path, "a", buffer, bufferCount);
+    if(success) entryCount += bufferCount;
+    else torn = true;   //what was lost is written by the next compaction
+    bufferCount = 0;
+  }
+
+  return(success);
+}
+
+bool DeviceStore::needsCompaction(uint32_t liveCount) {
+  return(open && (torn || entryCount + bufferCount > 2 * liveCount + APPROXIMATE_STORE_COMPACT_SLACK));
+}
+
+bool DeviceStore::beginCompaction() {
+  if(open) {
+    #if defined(APPROXIMATE_NATIVE)
+      compaction = fopen(compactionPath, "wb");
+      compacting = (compaction != NULL);
+    #else
+      compaction = LittleFS.open(compactionPath, "w");
+      compacting = (bool) compaction;
+    #endif
+    compactionEntryCount = 0;
+  }
+
+  return(compacting);
+}
+
+void DeviceStore::writeCompaction(Entry &entry) {
+  if(compacting) {
+    entry.check = checksum(entry);
+
+    #if defined(APPROXIMATE_NATIVE)
+      compacting = (fwrite(&entry, sizeof(entry), 1, compaction) == 1);
+    #else
+      compacting = (compaction.write((uint8_t *) &entry, sizeof(entry)) == sizeof(entry));
+    #endif
+    ++compactionEntryCount;
+  }
+}
+
+bool DeviceStore::endCompaction() {
+  bool success = compacting;
+
+  #if defined(APPROXIMATE_NATIVE)
+    if(compaction) fclose(compaction);
+    compaction = NULL;
+    //the log is replaced only by a complete new file:
+    if(success) success = (rename(compactionPath, path) == 0);
+  #else
+    compaction.close();
+    if(success) {
+      LittleFS.remove(path);
+      success = LittleFS.rename(compactionPath, path);
+    }
+  #endif
+
+  if(success) {
+    //the state written includes everything that was waiting to be appended
+    bufferCount = 0;
+    entryCount = compactionEntryCount;
+    torn = false;
+    ++compactionCount;
+  }
+  compacting = false;
+
+  return(success);
+}
+
+uint32_t DeviceStore::getEntryCount() {
+  return(entryCount);
+}
+
+uint32_t DeviceStore::getLoadedCount() {
+  return(loadedCount);
+}
+
+uint32_t DeviceStore::getCompactionCount() {
+  return(compactionCount);
+}
@@ -0,0 +1,120 @@
+/*
+    DeviceStore.h
+    Approximate Library
+    -
+    A journal of what has been learnt about devices, kept in flash (LittleFS)
+    or, in the host build, a plain file - so that it survives a restart. Each
+    change is appended as a fixed-size entry: a device that is proximate, with
+    its IP address and SSID; a device that has departed; a host resolved by
+    ARP. Reading the log back in order rebuilds the state. Entries are
+    appended only from loop(), gathered in a small buffer, so that flash is
+    written in a few larger pieces; and when the log has grown well beyond
+    the state it describes it is compacted - the state is written afresh to
+    another file, which then replaces the log. Each entry has a checksum, so
+    an entry left half-written by a loss of power ends the log.
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#ifndef DeviceStore_h
+#define DeviceStore_h
+
+#include <Arduino.h>
+#include "eth_addr.h"
+
+#if !defined(APPROXIMATE_NATIVE)
+  #include <LittleFS.h>
+#endif
+
+#ifndef APPROXIMATE_STORE_PATH
+  #define APPROXIMATE_STORE_PATH "/approximate.log"
+#endif
+
+//how often the changes since are appended to the log
+#ifndef APPROXIMATE_STORE_FLUSH_MS
+  #define APPROXIMATE_STORE_FLUSH_MS 10000
+#endif
+
+//entries gathered before they are written, between flushes
+#ifndef APPROXIMATE_STORE_BUFFER_ENTRIES
+  #define APPROXIMATE_STORE_BUFFER_ENTRIES 16
+#endif
+
+//the log is compacted once it holds this many more entries than twice the state it describes
+#ifndef APPROXIMATE_STORE_COMPACT_SLACK
+  #define APPROXIMATE_STORE_COMPACT_SLACK 64
+#endif
+
+class DeviceStore {
+  public:
+    typedef enum {
+      DEVICE = 1,       //proximate - macAddress, ipAddress, channel and ssid
+      FORGET = 2,       //departed - macAddress
+      HOST = 3          //resolved - macAddress and ipAddress
+    } EntryType;
+
+    static const uint8_t VERSION = 1;
+
+    typedef struct {
+      uint8_t type;
+      uint8_t version;
+      uint8_t macAddress[6];
+      uint32_t ipAddress;
+      uint8_t channel;
+      uint8_t ssidLength;
+      char ssid[32];
+      uint16_t check;                 //Fletcher-16 of the bytes before it
+    } Entry;
+
+    typedef void (*EntryHandler)(Entry &entry);
+
+  private:
+    char path[32] = {0};
+    char compactionPath[36] = {0};
+    bool open = false;
+
+    Entry buffer[APPROXIMATE_STORE_BUFFER_ENTRIES];
+    int bufferCount = 0;
+
+    #if defined(APPROXIMATE_NATIVE)
+      FILE *compaction = NULL;
+    #else
+      File compaction;
+    #endif
+    bool compacting = false;
+    uint32_t compactionEntryCount = 0;
+
+    uint32_t entryCount = 0;          //in the log
+    uint32_t loadedCount = 0;
+    uint32_t compactionCount = 0;
+    bool torn = false;                //the log ends in an entry that was not wholly written, or an append failed
+
+    static uint16_t checksum(Entry &entry);
+    static bool isValid(Entry &entry);
+    bool write(const char *path, const char *mode, Entry *entries, int count);
+
+  public:
+    bool begin(const char *path = APPROXIMATE_STORE_PATH);
+    void end();
+    bool isOpen();
+
+    //each entry of the log in turn, oldest first, skipping any that make no sense - the number read
+    int load(EntryHandler entryHandler);
+
+    static void toEntry(Entry &entry, EntryType type, eth_addr &macAddress, uint32_t ipAddress = IPADDR_ANY, int channel = 0, const char *ssid = NULL);
+    void append(Entry &entry);
+    bool flush();
+
+    //whether the log has grown beyond twice the liveCount entries needed to describe the state
+    bool needsCompaction(uint32_t liveCount);
+    bool beginCompaction();
+    void writeCompaction(Entry &entry);    //every entry of the state, between beginCompaction() and endCompaction()
+    bool endCompaction();
+
+    uint32_t getEntryCount();
+    uint32_t getLoadedCount();
+    uint32_t getCompactionCount();
+};
+
+#endif
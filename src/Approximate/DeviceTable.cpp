@@ -0,0 +1,259 @@
+/*
+    DeviceTable.cpp
+    Approximate Library
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include "DeviceTable.h"
+
+StringPool DeviceTable::ssids;
+
+DeviceTable::~DeviceTable() {
+  delete[] pool;
+  delete[] freeSlots;
+  delete[] activeSlots;
+  delete[] activePosition;
+  delete[] index;
+}
+
+bool DeviceTable::init(int capacity) {
+  bool success = false;
+
+  if(!pool && capacity > 0 && capacity < EMPTY / 2 && timeOuts.init(capacity, millis())) {
+    if(!ssids.isInitialised()) ssids.init(APPROXIMATE_MAX_SSIDS);
+
+    //the index is kept no more than half full
+    uint32_t indexSize = 2;
+    uint8_t bits = 1;
+    while(indexSize < (uint32_t) capacity * 2) {
+      indexSize <<= 1;
+      ++bits;
+    }
+    index = new uint16_t[indexSize];
+    mask = indexSize - 1;
+    shift = 64 - bits;
+
+    pool = new DeviceRecord[capacity];
+    freeSlots = new uint16_t[capacity];
+    activeSlots = new uint16_t[capacity];
+    activePosition = new uint16_t[capacity];
+    this -> capacity = capacity;
+    clear();
+
+    success = true;
+  }
+
+  return(success);
+}
+
+bool DeviceTable::isInitialised() {
+  return(pool != NULL);
+}
+
+DeviceRecord *DeviceTable::get(eth_addr &macAddress) {
+  DeviceRecord *record = NULL;
+
+  if(pool) {
+    for(uint32_t i = indexFor(macAddress.addr); index[i] != EMPTY; i = (i + 1) & mask) {
+      if(pool[index[i]].matches(macAddress.addr)) {
+        record = &pool[index[i]];
+        break;
+      }
+    }
+  }
+
+  return(record);
+}
+
+DeviceRecord *DeviceTable::get(int n) {
+  DeviceRecord *record = NULL;
+
+  if(n >= 0 && n < count) record = &pool[activeSlots[n]];
+
+  return(record);
+}
+
+DeviceRecord *DeviceTable::add(Device *device) {
+  DeviceRecord *record = NULL;
+
+  if(device && freeCount > 0) {
+    record = get(device -> macAddress);
+    if(!record) {
+      uint16_t slot = freeSlots[--freeCount];
+
+      record = &pool[slot];
+      memcpy(record -> macAddress, device -> macAddress.addr, 6);
+      addToIndex(slot);
+
+      activePosition[slot] = count;
+      activeSlots[count++] = slot;
+
+      record -> ssid = StringPool::NONE;
+      record -> rssiEstimator = device -> rssiEstimator;
+      record -> flags = 0;
+      record -> setProximate(device -> proximate);
+      record -> ipAddress = IPADDR_ANY;
+      record -> setChanged();
+      store(record, device);
+    }
+  }
+
+  return(record);
+}
+
+void DeviceTable::update(DeviceRecord *record, Device *device) {
+  if(record && device) store(record, device);
+}
+
+void DeviceTable::store(DeviceRecord *record, Device *device) {
+  memcpy(record -> bssid, device -> bssid.addr, 6);
+  record -> channel = device -> channel;
+  record -> rssi = min(max(device -> rssi, -128), 127);
+  record -> lastSeenTick = (uint16_t) ((uint32_t) device -> lastSeenAtMs >> DeviceRecord::LAST_SEEN_TICK_SHIFT);
+  record -> dataFlowBytes = min(max(device -> dataFlowBytes, -32768), 32767);
+  if(record -> ipAddress != device -> ipAddress.addr) {
+    record -> ipAddress = device -> ipAddress.addr;
+    record -> setChanged();
+  }
+
+  //the SSID learnt from the last frame that carried one - interned before the old one is
+  //released, so an unchanged SSID is never freed and found again
+  if(device -> hasSSID()) {
+    uint16_t ssid = ssids.intern(device -> ssid);
+    ssids.release(record -> ssid);
+    if(record -> ssid != ssid) {
+      record -> ssid = ssid;
+      record -> setChanged();
+    }
+  }
+}
+
+void DeviceTable::load(DeviceRecord *record, Device &device) {
+  eth_addr macAddress, bssid;
+  memcpy(macAddress.addr, record -> macAddress, 6);
+  memcpy(bssid.addr, record -> bssid, 6);
+
+  device.init(macAddress, bssid, record -> channel, record -> rssi, record -> getLastSeenAtMs(), record -> dataFlowBytes, record -> ipAddress);
+  device.setSSID(ssids.get(record -> ssid));
+  device.rssiEstimator = record -> rssiEstimator;
+  device.proximate = record -> isProximate();
+  device.timeOutAtMs = timeOuts.isScheduled(getSlot(record)) ? (long) timeOuts.getDeadlineMs(getSlot(record)) : -1;
+  device.trafficSummary.reset();
+}
+
+const char *DeviceTable::getSSID(DeviceRecord *record) {
+  return(ssids.get(record -> ssid));
+}
+
+DeviceRecord *DeviceTable::getAtSlot(int slot) {
+  DeviceRecord *record = NULL;
+
+  if(slot >= 0 && slot < capacity && activePosition[slot] < count && activeSlots[activePosition[slot]] == slot) record = &pool[slot];
+
+  return(record);
+}
+
+int DeviceTable::getSlot(DeviceRecord *record) {
+  return((record >= pool && record < pool + capacity) ? record - pool : -1);
+}
+
+void DeviceTable::addToIndex(uint16_t slot) {
+  uint32_t i = indexFor(pool[slot].macAddress);
+  while(index[i] != EMPTY) i = (i + 1) & mask;
+  index[i] = slot;
+}
+
+bool DeviceTable::removeFromIndex(uint16_t slot) {
+  uint32_t hole = indexFor(pool[slot].macAddress);
+  while(index[hole] != EMPTY && index[hole] != slot) hole = (hole + 1) & mask;
+
+  bool found = (index[hole] == slot);
+  if(found) {
+    //backward-shift deletion, as MacMap:
+    for(uint32_t j = (hole + 1) & mask; index[j] != EMPTY; j = (j + 1) & mask) {
+      uint32_t home = indexFor(pool[index[j]].macAddress);
+      if(((j - home) & mask) >= ((j - hole) & mask)) {
+        index[hole] = index[j];
+        hole = j;
+      }
+    }
+    index[hole] = EMPTY;
+  }
+
+  return(found);
+}
+
+bool DeviceTable::setMacAddress(DeviceRecord *record, eth_addr &macAddress) {
+  bool success = false;
+
+  int slot = getSlot(record);
+  if(slot >= 0 && !get(macAddress) && removeFromIndex(slot)) {
+    memcpy(record -> macAddress, macAddress.addr, 6);
+    addToIndex(slot);
+
+    //the sequence numbers of the old address say nothing of the new
+    record -> flags &= (DeviceRecord::PROXIMATE | DeviceRecord::EVICTED);
+    record -> setChanged();
+    success = true;
+  }
+
+  return(success);
+}
+
+void DeviceTable::remove(DeviceRecord *record) {
+  int slot = getSlot(record);
+
+  if(slot >= 0 && removeFromIndex(slot)) {
+    timeOuts.cancel(slot);
+    ssids.release(record -> ssid);
+    record -> ssid = StringPool::NONE;
+
+    //fill the gap in the dense list with its last entry:
+    uint16_t position = activePosition[slot];
+    uint16_t lastSlot = activeSlots[--count];
+    activeSlots[position] = lastSlot;
+    activePosition[lastSlot] = position;
+
+    freeSlots[freeCount++] = slot;
+  }
+}
+
+void DeviceTable::clear() {
+  for(int n = 0; n < count; ++n) {
+    timeOuts.cancel(activeSlots[n]);
+    ssids.release(pool[activeSlots[n]].ssid);
+  }
+  for(uint32_t i = 0; pool && i <= mask; ++i) index[i] = EMPTY;
+
+  count = 0;
+  freeCount = capacity;
+  for(int n = 0; n < capacity; ++n) freeSlots[n] = capacity - 1 - n;
+}
+
+void DeviceTable::setTimeOutAtMs(DeviceRecord *record, long timeOutAtMs) {
+  int slot = getSlot(record);
+  if(slot >= 0) timeOuts.schedule(slot, (uint32_t) timeOutAtMs);
+}
+
+DeviceRecord *DeviceTable::getTimedOut() {
+  DeviceRecord *record = NULL;
+
+  int slot = timeOuts.nextExpired(millis());
+  if(slot >= 0) record = &pool[slot];
+
+  return(record);
+}
+
+int DeviceTable::getCount() {
+  return(count);
+}
+
+int DeviceTable::getCapacity() {
+  return(capacity);
+}
+
+bool DeviceTable::isFull() {
+  return(pool != NULL && freeCount == 0);
+}
@@ -0,0 +1,107 @@
+/*
+    DeviceTable.h
+    Approximate Library
+    -
+    A fixed pool of DeviceRecords indexed by MAC address. Records never move
+    once added, so a DeviceRecord * stays valid until that device is removed.
+    Lookup is by hash, in an open-addressing index of pool slots that compares
+    the records' own MAC addresses - so the index costs 4 bytes a device - and
+    iteration is over a dense list of the records in use. Each record's time
+    out is kept in a TimerWheel, so finding those that have timed out does not
+    visit the rest. A record's slot is fixed too, so that other state can be
+    kept alongside the table in an array of getCapacity().
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#ifndef DeviceTable_h
+#define DeviceTable_h
+
+#include <Arduino.h>
+#include "eth_addr.h"
+
+#include "Device.h"
+#include "DeviceRecord.h"
+#include "StringPool.h"
+#include "TimerWheel.h"
+
+#ifndef APPROXIMATE_MAX_PROXIMATE_DEVICES
+  #if defined(ESP8266)
+    #define APPROXIMATE_MAX_PROXIMATE_DEVICES 64
+  #else
+    #define APPROXIMATE_MAX_PROXIMATE_DEVICES 256
+  #endif
+#endif
+
+#ifndef APPROXIMATE_MAX_SSIDS
+  #if defined(ESP8266)
+    #define APPROXIMATE_MAX_SSIDS 16
+  #else
+    #define APPROXIMATE_MAX_SSIDS 64    //distinct SSIDs held at once, across all tables - beyond that a record's SSID is left empty
+  #endif
+#endif
+
+class DeviceTable {
+  private:
+    static const uint16_t EMPTY = 0xFFFF;
+
+    DeviceRecord *pool = NULL;
+    uint16_t *freeSlots = NULL;     //stack of unused pool indices
+    uint16_t *activeSlots = NULL;   //dense list of used pool indices
+    uint16_t *activePosition = NULL;  //where each used pool index sits in activeSlots
+    int capacity = 0;
+    int freeCount = 0;
+    int count = 0;
+
+    uint16_t *index = NULL;         //pool indices, by hash of their MAC address
+    uint32_t mask = 0;
+    uint8_t shift = 64;
+
+    TimerWheel timeOuts;
+
+    static StringPool ssids;
+
+    inline uint32_t indexFor(const uint8_t *macAddress) {
+      //Fibonacci hashing, as MacMap
+      uint64_t key = ((uint64_t) macAddress[0] << 40) | ((uint64_t) macAddress[1] << 32) | ((uint64_t) macAddress[2] << 24) |
+                     ((uint64_t) macAddress[3] << 16) | ((uint64_t) macAddress[4] << 8) | (uint64_t) macAddress[5];
+      return((uint32_t) ((key * 0x9E3779B97F4A7C15ULL) >> shift));
+    }
+    void store(DeviceRecord *record, Device *device);
+    void addToIndex(uint16_t slot);
+    bool removeFromIndex(uint16_t slot);
+
+  public:
+    ~DeviceTable();
+
+    bool init(int capacity = APPROXIMATE_MAX_PROXIMATE_DEVICES);
+    bool isInitialised();
+
+    DeviceRecord *get(eth_addr &macAddress);
+    DeviceRecord *get(int n);         //0 <= n < getCount(), in no particular order
+
+    DeviceRecord *add(Device *device);   //NULL if the table is full
+    void update(DeviceRecord *record, Device *device);   //as Device::update() - but the RSSI estimate, proximity and, if the device has none, SSID are kept
+    void remove(DeviceRecord *record);
+    //the record is found by another MAC address, no longer its own - false if another record has that address
+    bool setMacAddress(DeviceRecord *record, eth_addr &macAddress);
+    void clear();
+
+    //the record as a Device - for a handler, so changes to it are not kept
+    void load(DeviceRecord *record, Device &device);
+    const char *getSSID(DeviceRecord *record);   //"" if it has none
+    int getSlot(DeviceRecord *record);   //0 <= slot < getCapacity()
+    DeviceRecord *getAtSlot(int slot);   //NULL if the slot is not in use
+
+    //sets the record's time out and re-arms it
+    void setTimeOutAtMs(DeviceRecord *record, long timeOutAtMs);
+    //a record that has timed out, which will not be returned again unless its time out is set again - or NULL
+    DeviceRecord *getTimedOut();
+
+    int getCount();
+    int getCapacity();
+    bool isFull();
+};
+
+#endif
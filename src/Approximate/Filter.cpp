@@ -8,6 +8,7 @@
 */
 
 #include "Filter.h"
+#include "FilterSet.h"
 
 eth_addr Filter::NONE = eth_addr({{0xff,0xff,0xff,0xff,0xff,0xff}});
 eth_addr Filter::ANY = eth_addr({{0x00,0x00,0x00,0x00,0x00,0x00}});
@@ -72,4 +73,21 @@ bool Filter::isOUIFilter() {
         this -> macAddress.addr[5] == 0xFF;
 
     return(result);
-}
\ No newline at end of file
+}
+
+uint8_t Filter::getDirectionMask() {
+    uint8_t mask = 0;
+
+    switch(direction) {
+        case EITHER:
+            mask = FilterSet::UPLOADING | FilterSet::DOWNLOADING | FilterSet::IDLE;  break;
+        case NEITHER:
+            mask = 0; break;
+        case SENDS:
+            mask = FilterSet::UPLOADING; break;
+        case RECEIVES:
+            mask = FilterSet::DOWNLOADING; break;
+    }
+
+    return(mask);
+}
@@ -34,6 +34,9 @@ class Filter {
         bool matches(eth_addr *macAddress);
         bool matches(Device *device);
         bool isOUIFilter();
+
+        //the data flows a device may have and still match, as FilterSet bits
+        uint8_t getDirectionMask();
 };
 
 #endif
\ No newline at end of file
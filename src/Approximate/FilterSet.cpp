@@ -0,0 +1,67 @@
+/*
+    FilterSet.cpp
+    Approximate Library
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include "FilterSet.h"
+
+void FilterSet::compile(List<Filter *> &filters) {
+  count = filters.Count();
+  anyMask = 0;
+
+  //sized for the case where every filter is of one kind:
+  macAddresses.init(max(count, 1));
+  ouis.init(max(count, 1));
+
+  for(int n = 0; n < count; ++n) {
+    Filter *filter = filters[n];
+    uint8_t mask = filter -> getDirectionMask();
+    uint64_t key = eth_addr_to_uint64(filter -> macAddress);
+
+    if(filter -> isOUIFilter()) add(ouis, key >> 24, mask);
+    else add(macAddresses, key, mask);
+
+    anyMask |= mask;
+  }
+}
+
+void FilterSet::add(MacMap &map, uint64_t key, uint8_t mask) {
+  //filters for the same address combine their directions
+  uint32_t existingMask = 0;
+  map.get(key, existingMask);
+  map.put(key, existingMask | mask);
+}
+
+bool FilterSet::matches(Device *device) {
+  bool result = false;
+
+  if(device && count > 0) {
+    eth_addr macAddress;
+    device -> getMacAddress(macAddress);
+
+    uint8_t flow = device -> isUploading() ? UPLOADING : (device -> isDownloading() ? DOWNLOADING : IDLE);
+
+    if(eth_addr_cmp(&macAddress, &Filter::ANY)) {
+      //every filter matches the ANY address
+      result = (anyMask & flow) != 0;
+    }
+    else if(!eth_addr_cmp(&macAddress, &Filter::NONE)) {
+      //and none match NONE
+      uint64_t key = eth_addr_to_uint64(macAddress);
+      uint32_t macAddressMask = 0, ouiMask = 0;
+      macAddresses.get(key, macAddressMask);
+      ouis.get(key >> 24, ouiMask);
+
+      result = ((macAddressMask | ouiMask) & flow) != 0;
+    }
+  }
+
+  return(result);
+}
+
+bool FilterSet::isEmpty() {
+  return(count == 0);
+}
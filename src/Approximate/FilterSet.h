@@ -0,0 +1,49 @@
+/*
+    FilterSet.h
+    Approximate Library
+    -
+    A list of Filters compiled for matching against every frame: full MAC
+    addresses and OUIs each go into their own hash map (see MacMap), holding
+    the data flow directions that pass for that address. Matching a device is
+    then two lookups, whatever the number of filters. It must be compiled
+    again whenever the list of Filters changes.
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#ifndef FilterSet_h
+#define FilterSet_h
+
+#include <Arduino.h>
+#include "eth_addr.h"
+
+#include "Device.h"
+#include "Filter.h"
+#include "MacMap.h"
+
+#include <ListLib.h>
+
+class FilterSet {
+  public:
+    //direction mask bits - the data flow of the device being matched
+    static const uint8_t UPLOADING = 0x1;
+    static const uint8_t DOWNLOADING = 0x2;
+    static const uint8_t IDLE = 0x4;
+
+  private:
+    MacMap macAddresses;    //full MAC address -> direction mask
+    MacMap ouis;            //24-bit OUI -> direction mask
+    uint8_t anyMask = 0;    //every mask together, for a device with the ANY address
+    int count = 0;
+
+    static void add(MacMap &map, uint64_t key, uint8_t mask);
+
+  public:
+    void compile(List<Filter *> &filters);
+
+    bool matches(Device *device);
+    bool isEmpty();
+};
+
+#endif
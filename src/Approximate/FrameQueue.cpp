@@ -0,0 +1,70 @@
+/*
+    FrameQueue.cpp
+    Approximate Library
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include "FrameQueue.h"
+
+#define FRAME_QUEUE_MASK (APPROXIMATE_FRAME_QUEUE_LENGTH - 1)
+
+bool FrameQueue::push(wifi_pkt_rx_ctrl_t *rx_ctrl, uint8_t *frame, uint16_t length, uint16_t capturedLength, int type) {
+  bool success = false;
+
+  uint32_t h = head;
+  uint32_t t = __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+
+  if((h - t) < APPROXIMATE_FRAME_QUEUE_LENGTH) {
+    FrameRecord *record = &records[h & FRAME_QUEUE_MASK];
+    record -> rssi = rx_ctrl -> rssi;
+    record -> channel = rx_ctrl -> channel;
+    record -> type = type;
+    record -> length = length;
+    record -> snapLength = min((int) min(length, capturedLength), APPROXIMATE_FRAME_SNAP_BYTES);
+    memcpy(record -> frame, frame, record -> snapLength);
+
+    //publish the record only once it is complete:
+    __atomic_store_n(&head, h + 1, __ATOMIC_RELEASE);
+
+    if((h + 1 - t) > highWaterMark) highWaterMark = h + 1 - t;
+    success = true;
+  }
+  else {
+    droppedCount = droppedCount + 1;
+  }
+
+  return(success);
+}
+
+FrameRecord *FrameQueue::front() {
+  FrameRecord *record = NULL;
+
+  uint32_t t = tail;
+  if(__atomic_load_n(&head, __ATOMIC_ACQUIRE) != t) {
+    record = &records[t & FRAME_QUEUE_MASK];
+  }
+
+  return(record);
+}
+
+void FrameQueue::pop() {
+  uint32_t t = tail;
+  if(__atomic_load_n(&head, __ATOMIC_ACQUIRE) != t) {
+    __atomic_store_n(&tail, t + 1, __ATOMIC_RELEASE);
+  }
+}
+
+uint32_t FrameQueue::getDroppedCount() {
+  return(droppedCount);
+}
+
+uint32_t FrameQueue::getHighWaterMark() {
+  return(highWaterMark);
+}
+
+void FrameQueue::resetCounters() {
+  droppedCount = 0;
+  highWaterMark = 0;
+}
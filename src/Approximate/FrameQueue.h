@@ -0,0 +1,63 @@
+/*
+    FrameQueue.h
+    Approximate Library
+    -
+    A single-producer/single-consumer ring of compact frame records. The Wi-Fi
+    driver's promiscuous callback is the only producer and loop() the only
+    consumer, so no locks are needed - only ordered loads and stores of the
+    head and tail indices.
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#ifndef FrameQueue_h
+#define FrameQueue_h
+
+#include <Arduino.h>
+#include "eth_addr.h"
+#include "wifi_pkt.h"
+
+#ifndef APPROXIMATE_FRAME_QUEUE_LENGTH
+  #define APPROXIMATE_FRAME_QUEUE_LENGTH 32   //must be a power of two
+#endif
+
+//Only the start of each frame is kept: the MAC header and the first of the
+//Information Elements (IEs) of management frames.
+#ifndef APPROXIMATE_FRAME_SNAP_BYTES
+  #define APPROXIMATE_FRAME_SNAP_BYTES 88
+#endif
+
+typedef struct {
+  int8_t rssi;
+  uint8_t channel;
+  uint8_t type;                 //wifi_promiscuous_pkt_type_t
+  uint8_t snapLength;           //bytes of frame[] that are valid
+  uint16_t length;              //length of the whole frame, as reported by the radio
+  uint8_t frame[APPROXIMATE_FRAME_SNAP_BYTES];
+} FrameRecord;
+
+class FrameQueue {
+  private:
+    FrameRecord records[APPROXIMATE_FRAME_QUEUE_LENGTH];
+
+    volatile uint32_t head = 0;   //written only by the producer
+    volatile uint32_t tail = 0;   //written only by the consumer
+
+    volatile uint32_t droppedCount = 0;
+    uint32_t highWaterMark = 0;
+
+  public:
+    //producer - capturedLength is how much of the frame the driver passed, which may be less than its length:
+    bool push(wifi_pkt_rx_ctrl_t *rx_ctrl, uint8_t *frame, uint16_t length, uint16_t capturedLength, int type);
+
+    //consumer:
+    FrameRecord *front();
+    void pop();
+
+    uint32_t getDroppedCount();
+    uint32_t getHighWaterMark();
+    void resetCounters();
+};
+
+#endif
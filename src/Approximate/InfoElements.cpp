@@ -0,0 +1,98 @@
+/*
+    InfoElements.cpp
+    Approximate Library
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include "InfoElements.h"
+
+uint16_t InfoElements::parse(const uint8_t *frame, size_t offset, size_t length, uint16_t wanted, uint64_t *fingerprint) {
+  this -> frame = frame;
+  found = 0;
+  vendorSpecificCount = 0;
+  truncated = false;
+
+  //FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+
+  if(frame) {
+    size_t end = offset + length;
+    bool complete = false;
+
+    //each element is its id, the length of its data and then the data
+    while(!complete && offset + 2 <= end) {
+      uint8_t elementLength = frame[offset + 1];
+      if(offset + 2 + elementLength > end) break;
+
+      if(fingerprint) {
+        const uint8_t *data = frame + offset + 2;
+        int hashLength = 0;
+        switch(frame[offset]) {
+          case IE_SUPPORTED_RATES:
+          case IE_EXT_SUPPORTED_RATES:
+          case IE_HT_CAPABILITIES:
+          case IE_EXT_CAPABILITIES:
+          case IE_VHT_CAPABILITIES:     hashLength = elementLength; break;
+          case IE_VENDOR_SPECIFIC:      hashLength = min((int) elementLength, 4); break;    //the OUI and type
+        }
+
+        hash = (hash ^ frame[offset]) * 1099511628211ULL;
+        for(int n = 0; n < hashLength; ++n) hash = (hash ^ data[n]) * 1099511628211ULL;
+      }
+
+      int element = toElement(frame[offset]);
+      if(element >= 0 && (wanted & (1 << element))) {
+        if(element == VENDOR_SPECIFIC && vendorSpecificCount < 0xFF) ++vendorSpecificCount;
+
+        if(!(found & (1 << element))) {
+          found |= (1 << element);
+          this -> offset[element] = offset + 2;
+          this -> length[element] = elementLength;
+
+          //vendor-specific elements are only all counted at the end - and every element is fingerprinted
+          complete = (found == wanted) && !(wanted & (1 << VENDOR_SPECIFIC)) && !fingerprint;
+        }
+      }
+
+      offset += 2 + elementLength;
+    }
+
+    truncated = !complete && offset != end;
+  }
+
+  if(fingerprint) *fingerprint = (hash != 0 && ~hash != 0) ? hash : 1;
+
+  return(found);
+}
+
+bool InfoElements::has(Element element) {
+  return(found & (1 << element));
+}
+
+const uint8_t *InfoElements::get(Element element, uint8_t &length) {
+  const uint8_t *data = NULL;
+
+  if(has(element)) {
+    data = frame + offset[element];
+    length = this -> length[element];
+  }
+  else {
+    length = 0;
+  }
+
+  return(data);
+}
+
+int InfoElements::getOffset(Element element) {
+  return(has(element) ? offset[element] : -1);
+}
+
+int InfoElements::getVendorSpecificCount() {
+  return(vendorSpecificCount);
+}
+
+bool InfoElements::isTruncated() {
+  return(truncated);
+}
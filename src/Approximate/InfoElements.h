@@ -0,0 +1,83 @@
+/*
+    InfoElements.h
+    Approximate Library
+    -
+    The Information Elements of a management frame's body, found in a single
+    bounds-checked pass. Only the elements asked for - a mask of (1 << Element)
+    bits - are kept, each as an offset into the frame and a length, so nothing
+    is copied; and the walk stops once every one asked for has been found. The
+    first of a repeated element is kept, but vendor-specific elements - which
+    are often repeated - are also counted, so asking for them walks every
+    element. The walk can also fingerprint the frame's sender: a 64-bit hash of
+    the order of its elements and the content of those that describe its radio
+    rather than what it is looking for - rates, capabilities and the vendors of
+    vendor-specific elements. A device that hides behind a new random MAC address
+    each time it scans keeps the same fingerprint, though so may others of the
+    same model.
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#ifndef InfoElements_h
+#define InfoElements_h
+
+#include <Arduino.h>
+#include "eth_addr.h"
+#include "wifi_pkt.h"
+
+class InfoElements {
+  public:
+    typedef enum {
+      SSID,
+      SUPPORTED_RATES,
+      DS_PARAMETER_SET,
+      TIM,
+      COUNTRY,
+      HT_CAPABILITIES,
+      RSN,
+      EXTENDED_SUPPORTED_RATES,
+      EXTENDED_CAPABILITIES,
+      VHT_CAPABILITIES,
+      VENDOR_SPECIFIC,
+      ELEMENT_COUNT
+    } Element;
+
+  private:
+    const uint8_t *frame = NULL;
+    uint16_t found = 0;
+    uint16_t offset[ELEMENT_COUNT];   //of each element's data, from the start of the frame
+    uint8_t length[ELEMENT_COUNT];
+    uint8_t vendorSpecificCount = 0;
+    bool truncated = false;
+
+    static inline int toElement(uint8_t id) {
+      switch(id) {
+        case IE_SSID:                   return(SSID);
+        case IE_SUPPORTED_RATES:        return(SUPPORTED_RATES);
+        case IE_DS_PARAM_SET:           return(DS_PARAMETER_SET);
+        case IE_TIM:                    return(TIM);
+        case IE_COUNTRY:                return(COUNTRY);
+        case IE_HT_CAPABILITIES:        return(HT_CAPABILITIES);
+        case IE_RSN:                    return(RSN);
+        case IE_EXT_SUPPORTED_RATES:    return(EXTENDED_SUPPORTED_RATES);
+        case IE_EXT_CAPABILITIES:       return(EXTENDED_CAPABILITIES);
+        case IE_VHT_CAPABILITIES:       return(VHT_CAPABILITIES);
+        case IE_VENDOR_SPECIFIC:        return(VENDOR_SPECIFIC);
+        default:                        return(-1);
+      }
+    }
+
+  public:
+    //the elements of the length bytes of frame from offset - those of wanted that were found; and, given
+    //somewhere to put it, the fingerprint of every element - never 0 nor all ones, so it can be a MacMap key
+    uint16_t parse(const uint8_t *frame, size_t offset, size_t length, uint16_t wanted, uint64_t *fingerprint = NULL);
+
+    bool has(Element element);
+    const uint8_t *get(Element element, uint8_t &length);   //the element's data, in the frame - NULL if it was not found
+    int getOffset(Element element);                          //of the element's data, from the start of the frame - -1 if it was not found
+    int getVendorSpecificCount();                            //if they were wanted
+    bool isTruncated();                                      //the last element ran beyond the body
+};
+
+#endif
@@ -0,0 +1,164 @@
+/*
+    MacMap.cpp
+    Approximate Library
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include "MacMap.h"
+
+MacMap::~MacMap() {
+  delete[] keys;
+  delete[] values;
+}
+
+bool MacMap::init(int maxCount) {
+  bool success = false;
+
+  if(maxCount > 0) {
+    uint32_t capacity = 2;
+    uint8_t bits = 1;
+    while(capacity < (uint32_t) maxCount * 2) {
+      capacity <<= 1;
+      ++bits;
+    }
+
+    if(!keys || capacity > mask + 1) {
+      delete[] keys;
+      delete[] values;
+      keys = new uint64_t[capacity];
+      values = new uint32_t[capacity];
+
+      mask = capacity - 1;
+      shift = 64 - bits;
+    }
+    this -> maxCount = (mask + 1) / 2;
+    clear();
+
+    success = true;
+  }
+
+  return(success);
+}
+
+bool MacMap::isInitialised() {
+  return(keys != NULL);
+}
+
+bool MacMap::get(uint64_t key, uint32_t &value) {
+  bool found = false;
+
+  if(keys) {
+    for(uint32_t i = slotFor(key); keys[i] != EMPTY; i = (i + 1) & mask) {
+      if(keys[i] == key) {
+        value = values[i];
+        found = true;
+        break;
+      }
+    }
+  }
+
+  return(found);
+}
+
+bool MacMap::contains(uint64_t key) {
+  uint32_t value;
+  return(get(key, value));
+}
+
+bool MacMap::put(uint64_t key, uint32_t value) {
+  bool success = false;
+
+  if(keys) {
+    uint32_t i = slotFor(key);
+    while(keys[i] != EMPTY && keys[i] != key) i = (i + 1) & mask;
+
+    if(keys[i] == key) {
+      values[i] = value;
+      success = true;
+    }
+    else if(count < maxCount) {
+      keys[i] = key;
+      values[i] = value;
+      ++count;
+      success = true;
+    }
+  }
+
+  return(success);
+}
+
+bool MacMap::remove(uint64_t key) {
+  bool success = false;
+
+  if(keys) {
+    uint32_t i = slotFor(key);
+    while(keys[i] != EMPTY && keys[i] != key) i = (i + 1) & mask;
+
+    if(keys[i] == key) {
+      //shift back any later entries of the run that would no longer be reachable:
+      uint32_t hole = i;
+      for(uint32_t j = (i + 1) & mask; keys[j] != EMPTY; j = (j + 1) & mask) {
+        uint32_t home = slotFor(keys[j]);
+        if(((j - home) & mask) >= ((j - hole) & mask)) {
+          keys[hole] = keys[j];
+          values[hole] = values[j];
+          hole = j;
+        }
+      }
+      keys[hole] = EMPTY;
+
+      --count;
+      success = true;
+    }
+  }
+
+  return(success);
+}
+
+bool MacMap::findKey(uint32_t value, uint64_t &key) {
+  bool found = false;
+
+  if(keys) {
+    for(uint32_t i = 0; i <= mask && !found; ++i) {
+      if(keys[i] != EMPTY && values[i] == value) {
+        key = keys[i];
+        found = true;
+      }
+    }
+  }
+
+  return(found);
+}
+
+bool MacMap::getEntry(int slot, uint64_t &key, uint32_t &value) {
+  bool found = false;
+
+  if(keys && slot >= 0 && (uint32_t) slot <= mask && keys[slot] != EMPTY) {
+    key = keys[slot];
+    value = values[slot];
+    found = true;
+  }
+
+  return(found);
+}
+
+int MacMap::getSlotCount() {
+  return(keys ? mask + 1 : 0);
+}
+
+void MacMap::clear() {
+  if(keys) {
+    for(uint32_t i = 0; i <= mask; ++i) keys[i] = EMPTY;
+  }
+  count = 0;
+}
+
+int MacMap::getCount() {
+  return(count);
+}
+
+int MacMap::getMaxCount() {
+  return(maxCount);
+}
@@ -0,0 +1,58 @@
+/*
+    MacMap.h
+    Approximate Library
+    -
+    An open-addressing hash map from a 48-bit MAC address to a 32-bit value
+    (typically an index into a fixed pool). The capacity is fixed when the map
+    is allocated - it never rehashes - and collisions are resolved by linear
+    probing, with backward-shift deletion so that no tombstones accumulate.
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#ifndef MacMap_h
+#define MacMap_h
+
+#include <Arduino.h>
+#include "eth_addr.h"
+
+class MacMap {
+  private:
+    static const uint64_t EMPTY = 0xFFFFFFFFFFFFFFFFULL;   //never a 48-bit key
+
+    uint64_t *keys = NULL;
+    uint32_t *values = NULL;
+    uint32_t mask = 0;
+    uint8_t shift = 64;
+    int count = 0;
+    int maxCount = 0;
+
+    inline uint32_t slotFor(uint64_t key) {
+      //Fibonacci hashing - the top bits of the product are well mixed
+      return((uint32_t) ((key * 0x9E3779B97F4A7C15ULL) >> shift));
+    }
+
+  public:
+    ~MacMap();
+
+    //room for at least maxCount keys at no more than half load - allocating only if
+    //the map has never been initialised, or was initialised smaller; always empties the map
+    bool init(int maxCount);
+    bool isInitialised();
+
+    bool get(uint64_t key, uint32_t &value);
+    bool contains(uint64_t key);
+    bool put(uint64_t key, uint32_t value);   //false if full
+    bool remove(uint64_t key);
+    bool findKey(uint32_t value, uint64_t &key);   //a search of the whole map
+    //the entry at one slot of the map, if it is used - for visiting every entry, 0 <= slot < getSlotCount()
+    bool getEntry(int slot, uint64_t &key, uint32_t &value);
+    int getSlotCount();
+    void clear();
+
+    int getCount();
+    int getMaxCount();
+};
+
+#endif
@@ -13,9 +13,24 @@ PacketSniffer::PacketEventHandler PacketSniffer::packetEventHandler = NULL;
 PacketSniffer::ChannelEventHandler PacketSniffer::channelEventHandler = NULL;
 bool PacketSniffer::running = false;
 
+bool PacketSniffer::deferred = false;
+FrameQueue *PacketSniffer::frameQueue = NULL;
+
 eth_addr PacketSniffer::localBSSID = {{0,0,0,0,0,0}};
 char PacketSniffer::countryCode[3] = {0};
 char PacketSniffer::countryEnvironment = 0;
+bool PacketSniffer::localBeaconSeen = false;
+uint32_t PacketSniffer::localBeaconChecksum = 0;
+uint16_t PacketSniffer::localBeaconTimOffset = 0;
+
+ChannelScheduler PacketSniffer::channelScheduler;
+
+#if !defined(APPROXIMATE_NO_STATS)
+  PacketSniffer::Stats PacketSniffer::stats;
+#endif
+
+uint8_t PacketSniffer::frameMask = PacketSniffer::FRAME_ALL;
+uint16_t PacketSniffer::ctrlSubtypeMask = 0xFFFF;
 
 PacketSniffer::PacketSniffer() {
   Serial.println("PacketSniffer::PacketSniffer");
@@ -63,6 +78,7 @@ bool PacketSniffer::begin() {
 
       esp_wifi_set_promiscuous(true);
       esp_wifi_set_promiscuous_rx_cb(&rxCallback_32);
+      applyFrameFilter();
 
       if(CSI_ENABLED && esp_wifi_set_csi(true) == ESP_OK) {
         //See: https://docs.espressif.com/projects/esp-idf/en/latest/esp32/api-reference/network/esp_wifi.html#_CPPv424esp_wifi_set_promiscuousb
@@ -112,14 +128,13 @@ void PacketSniffer::end() {
 
 void PacketSniffer::loop() {
   if(running) {
-    if(channelScan) {
-      long now = millis();
-      if((channelSamplingStartedAtMs + channelSamplingIntervalMs) < now) {
-        channelSamplingStartedAtMs = now;
+    if(deferred) processFrameQueue();
 
-        currentChannel += 1;
-        if(currentChannel > highestChannel) currentChannel = 1;
-        
+    if(channelScan) {
+      //the busier a channel has been, the longer it is listened to
+      int nextChannel = channelScheduler.loop(millis());
+      if(nextChannel) {
+        currentChannel = nextChannel;
         setCurrentChannel(currentChannel);
       }
     }
@@ -152,6 +167,8 @@ void PacketSniffer::setCurrentChannel(int channel) {
     if(esp_wifi_set_channel(currentChannel, WIFI_SECOND_CHAN_NONE) == ESP_OK) {
       currentChannel = channel;
     }
+  #elif defined(APPROXIMATE_NATIVE)
+    currentChannel = channel;
   #endif
 }
 
@@ -163,6 +180,8 @@ uint8_t PacketSniffer::getCurrentChannel() {
   #elif defined(ESP32)
     wifi_second_chan_t secondChannel;
     esp_wifi_get_channel(&currentChannel, &secondChannel);
+  #elif defined(APPROXIMATE_NATIVE)
+    currentChannel = this -> currentChannel;
   #endif
 
   return(currentChannel);
@@ -176,6 +195,43 @@ void PacketSniffer::setChannelScan(bool channelScan) {
   this->channelScan = channelScan;
 }
 
+ChannelScheduler *PacketSniffer::getChannelScheduler() {
+  return(&channelScheduler);
+}
+
+void PacketSniffer::setFrameFilter(uint8_t frameMask, uint16_t ctrlSubtypeMask) {
+  this -> frameMask = frameMask & FRAME_ALL;
+  this -> ctrlSubtypeMask = ctrlSubtypeMask;
+
+  if(running) applyFrameFilter();
+}
+
+uint8_t PacketSniffer::getFrameFilter() {
+  return(frameMask);
+}
+
+uint16_t PacketSniffer::getCtrlFrameFilter() {
+  return(ctrlSubtypeMask);
+}
+
+void PacketSniffer::applyFrameFilter() {
+  #if defined(ESP32)
+    //frames that no handler wants are dropped by the driver, so never wake the callback
+    wifi_promiscuous_filter_t filter;
+    filter.filter_mask = 0;
+    if(frameMask & FRAME_MGMT) filter.filter_mask |= WIFI_PROMIS_FILTER_MASK_MGMT;
+    if(frameMask & FRAME_CTRL) filter.filter_mask |= WIFI_PROMIS_FILTER_MASK_CTRL;
+    if(frameMask & FRAME_DATA) filter.filter_mask |= WIFI_PROMIS_FILTER_MASK_DATA;
+    if(frameMask & FRAME_MISC) filter.filter_mask |= WIFI_PROMIS_FILTER_MASK_MISC;
+    esp_wifi_set_promiscuous_filter(&filter);
+
+    //the driver's control frame masks are for subtypes 7 (wrapper) to 15 (CF-End + CF-Ack), from bit 23 up
+    wifi_promiscuous_filter_t ctrlFilter;
+    ctrlFilter.filter_mask = ((uint32_t) (ctrlSubtypeMask & 0xFF80)) << 16;
+    esp_wifi_set_promiscuous_ctrl_filter(&ctrlFilter);
+  #endif
+}
+
 void PacketSniffer::setPacketEventHandler(PacketEventHandler packetEventHandler) {
   this -> packetEventHandler = packetEventHandler;
 }
@@ -184,6 +240,66 @@ void PacketSniffer::setChannelEventHandler(ChannelEventHandler channelEventHandl
   this -> channelEventHandler = channelEventHandler;
 }
 
+void PacketSniffer::setDeferred(bool deferred) {
+  //the queue is never freed - the radio callback may still be writing to it
+  if(deferred && !frameQueue) frameQueue = new FrameQueue();
+
+  this -> deferred = deferred && frameQueue;
+}
+
+bool PacketSniffer::isDeferred() {
+  return(deferred);
+}
+
+uint32_t PacketSniffer::getDroppedFrameCount() {
+  return(frameQueue ? frameQueue -> getDroppedCount() : 0);
+}
+
+uint32_t PacketSniffer::getQueueHighWaterMark() {
+  return(frameQueue ? frameQueue -> getHighWaterMark() : 0);
+}
+
+void PacketSniffer::getStats(Stats &stats) {
+  #if defined(APPROXIMATE_NO_STATS)
+    stats = Stats();
+  #else
+    stats = PacketSniffer::stats;
+  #endif
+}
+
+void PacketSniffer::resetStats() {
+  #if !defined(APPROXIMATE_NO_STATS)
+    stats = Stats();
+  #endif
+}
+
+void PacketSniffer::processFrameQueue() {
+  static uint8_t buffer[sizeof(wifi_promiscuous_pkt_t) + APPROXIMATE_FRAME_SNAP_BYTES] __attribute__((aligned(4)));
+  wifi_promiscuous_pkt_t *packet = (wifi_promiscuous_pkt_t *) buffer;
+
+  //bounded, so that a flood of frames cannot starve the rest of loop()
+  for(int n = 0; n < APPROXIMATE_FRAME_QUEUE_LENGTH; ++n) {
+    FrameRecord *record = frameQueue -> front();
+    if(!record) break;
+
+    memset(&(packet -> rx_ctrl), 0, sizeof(wifi_pkt_rx_ctrl_t));
+    packet -> rx_ctrl.rssi = record -> rssi;
+    packet -> rx_ctrl.channel = record -> channel;
+    memcpy(packet -> payload, record -> frame, record -> snapLength);
+
+    int type = record -> type;
+    int subtype = ((wifi_80211_fctl *) record -> frame) -> subtype;
+
+    //data frames are reported by their full size, other frames are only parsed as far as they were kept - a snapshot
+    //shorter than the frame holds none of its 4-byte FCS, so the length given is as if it did
+    uint16_t len = (type == WIFI_PKT_DATA) ? record -> length : min((int) record -> length, record -> snapLength + 4);
+
+    frameQueue -> pop();
+
+    if(packetEventHandler) packetEventHandler(packet, len, type, subtype);
+  }
+}
+
 uint8_t* PacketSniffer::getFrameStart(wifi_promiscuous_pkt_t *pkt) {
   #if defined(ESP8266)
     // 802.11n AMPDU subframes have a 4-byte delimiter (MPDU length + CRC +
@@ -199,16 +315,32 @@ uint8_t* PacketSniffer::getFrameStart(wifi_promiscuous_pkt_t *pkt) {
 
 void PacketSniffer::rxCallback_8266(uint8_t *buf, uint16_t len) {
   wifi_promiscuous_pkt_t *packet = (wifi_promiscuous_pkt_t *) buf;
+
+  //the SDK passes rx_ctrl alone for some frames; otherwise the first 112 bytes of a management frame (a buffer of 128)
+  //or the first 36 of any other, each followed by counts that are not part of the frame
+  if(len <= sizeof(wifi_pkt_rx_ctrl_t)) {
+    APPROXIMATE_STATS_COUNT(stats.framesRejected);
+    return;
+  }
+  uint16_t bufferLength = (len == 128) ? 112 : 36;
+
   wifi_80211_data_frame *frame = (wifi_80211_data_frame *) getFrameStart(packet);
+  uint16_t capturedLength = bufferLength - (uint16_t) ((uint8_t *) frame - packet -> payload);
   wifi_promiscuous_pkt_type_t type = frame->fctl.type;
   int subtype = frame->fctl.subtype;
 
+  //there is no filter in the ESP8266 driver - reject unwanted frames before any more work is done
+  if(!isFrameWanted(type, subtype)) {
+    APPROXIMATE_STATS_COUNT(stats.framesRejected);
+    return;
+  }
+
   uint16_t sig_len = 0;
   #if defined(ESP8266)
     sig_len = packet->rx_ctrl.sig_mode ? packet->rx_ctrl.HT_length : packet->rx_ctrl.legacy_length;
   #endif
 
-  rxCallback(packet, sig_len, type, subtype);
+  rxCallback(packet, sig_len, capturedLength, type, subtype);
 }
 
 void PacketSniffer::rxCallback_32(void* buf, wifi_promiscuous_pkt_type_t type) {
@@ -216,20 +348,48 @@ void PacketSniffer::rxCallback_32(void* buf, wifi_promiscuous_pkt_type_t type) {
   wifi_80211_data_frame *frame = (wifi_80211_data_frame *) getFrameStart(packet);
   int subtype = frame->fctl.subtype;
 
+  #if defined(APPROXIMATE_NATIVE)
+    //on the ESP32 the driver has already applied the filter
+    if(!isFrameWanted(type, subtype)) {
+      APPROXIMATE_STATS_COUNT(stats.framesRejected);
+      return;
+    }
+  #endif
+
   uint16_t sig_len = 0;
-  #if defined(ESP32)
+  #if defined(ESP32) || defined(APPROXIMATE_NATIVE)
     sig_len = packet->rx_ctrl.sig_len;
   #endif
 
-  rxCallback(packet, sig_len, type, subtype);
+  //the whole frame is passed
+  rxCallback(packet, sig_len, sig_len, type, subtype);
 }
 
-void PacketSniffer::rxCallback(wifi_promiscuous_pkt_t *packet, uint16_t len, wifi_promiscuous_pkt_type_t type, int subtype) {
+void PacketSniffer::rxCallback(wifi_promiscuous_pkt_t *packet, uint16_t len, uint16_t capturedLength, wifi_promiscuous_pkt_type_t type, int subtype) {
   if (running && packetEventHandler) {
-    packetEventHandler(packet, len, (int) type, subtype);
+    APPROXIMATE_STATS_START(startCycles);
+    APPROXIMATE_STATS_COUNT(stats.framesBySubtype[type & 0x3][subtype & 0xF]);
+
+    channelScheduler.onFrame(packet -> rx_ctrl.channel);
+
+    if(deferred) {
+      //parsed later by loop() - keep the driver's callback short
+      frameQueue -> push(&(packet -> rx_ctrl), getFrameStart(packet), len, capturedLength, type);
+    }
+    else {
+      packetEventHandler(packet, len, (int) type, subtype);
+    }
+
+    APPROXIMATE_STATS_LATENCY(stats.callbackCycles, startCycles);
   }
 }
 
+#if defined(APPROXIMATE_NATIVE)
+void PacketSniffer::replay(wifi_promiscuous_pkt_t *packet, wifi_promiscuous_pkt_type_t type) {
+  rxCallback_32(packet, type);
+}
+#endif
+
 void PacketSniffer::csiCallback_32(void *ctx, wifi_csi_info_t *data) {
   if (running && channelEventHandler) {
     channelEventHandler(data);
@@ -238,6 +398,7 @@ void PacketSniffer::csiCallback_32(void *ctx, wifi_csi_info_t *data) {
 
 void PacketSniffer::setLocalBSSID(eth_addr &bssid) {
   ETHADDR16_COPY(&localBSSID, &bssid);
+  localBeaconSeen = false;
 }
 
 String PacketSniffer::getCountryCode() {
@@ -275,40 +436,42 @@ bool PacketSniffer::parseMgmtFrame(wifi_promiscuous_pkt_t *wifi_pkt, uint16_t le
     int rssi = rx_ctrl->rssi;
     int channel = rx_ctrl->channel;
 
-    // Calculate the size of the management frame header
+    // The frame body - fixed fields by subtype, then Information Elements - follows the header
     const size_t mgmt_hdr_size = sizeof(wifi_80211_mgmt_frame);
+    size_t frameLength = getFrameLength(len, WIFI_PKT_MGMT);
+    size_t bodyLength = frameLength > mgmt_hdr_size ? frameLength - mgmt_hdr_size : 0;
+
+    InfoElements elements;
 
     switch(subtype) {
       case PROBE_REQ:
-        // Probe requests are sent by all WiFi devices scanning for networks.
-        // The source MAC (addr2) is the device transmitting the probe.
+      case ASSOCIATION_REQ:
+      case REASSOCIATION_REQ: {
+        // Probe requests are sent by all WiFi devices scanning for networks, and association
+        // requests by those joining one. The source MAC (addr2) is the device transmitting.
         // Probe requests often have broadcast BSSID (FF:FF:FF:FF:FF:FF).
         device->init(srcAddr, bssidAddr, channel, rssi, millis(), 0);
-        ArpTable::lookupIPAddress(device);
-
-        // Parse Information Elements looking for SSID (IE id 0)
-        if(len > mgmt_hdr_size) {
-          const uint8_t *ie_ptr = frame->payload;
-          size_t ie_remaining = len - mgmt_hdr_size;
-
-          while(ie_remaining >= 2) {
-            const wifi_80211_ie *ie = (const wifi_80211_ie *) ie_ptr;
-            if(ie_remaining < (size_t)(2 + ie->length)) break;
-
-            if(ie->id == IE_SSID && ie->length > 0 && ie->length <= 32) {
-              char ssid_buf[33];
-              memcpy(ssid_buf, ie->data, ie->length);
-              ssid_buf[ie->length] = '\0';
-              device->setSSID(ssid_buf);
-            }
 
-            ie_ptr += 2 + ie->length;
-            ie_remaining -= 2 + ie->length;
-          }
+        // Fixed fields: none for a probe request; capability info and listen interval (4 bytes) for an
+        // association request, and the current AP's address (6 more) for a reassociation request
+        size_t fixedFieldsSize = (subtype == PROBE_REQ) ? 0 : (subtype == ASSOCIATION_REQ) ? 4 : 10;
+
+        if(bodyLength > fixedFieldsSize) {
+          // A probe request is fingerprinted as its elements are walked - so that a device can be followed
+          // from one random MAC address to the next
+          uint64_t probeFingerprint = 0;
+          elements.parse((uint8_t *) frame, mgmt_hdr_size + fixedFieldsSize, bodyLength - fixedFieldsSize, (1 << InfoElements::SSID), (subtype == PROBE_REQ) ? &probeFingerprint : NULL);
+          device->setProbeFingerprint(probeFingerprint);
+
+          // The SSID (IE id 0) is the network probed for or joined - empty for a probe of any network
+          uint8_t ssidLength;
+          const uint8_t *ssid = elements.get(InfoElements::SSID, ssidLength);
+          if(ssidLength > 0 && ssidLength <= 32) device->setSSID((const char *) ssid, ssidLength);
         }
 
         success = true;
         break;
+      }
 
       case PROBE_RES:
       case BEACON:
@@ -319,39 +482,48 @@ bool PacketSniffer::parseMgmtFrame(wifi_promiscuous_pkt_t *wifi_pkt, uint16_t le
           device->init(srcAddr, bssidAddr, channel, rssi, millis(), 0);
 
           // Parse Country IE from beacon/probe response body.
-          // Frame body starts after mgmt header with 12 bytes of fixed fields:
-          //   8-byte timestamp + 2-byte beacon interval + 2-byte capability info
+          // Fixed fields: 8-byte timestamp + 2-byte beacon interval + 2-byte capability info
           const size_t fixedFieldsSize = 12;
-          if(len > mgmt_hdr_size + fixedFieldsSize) {
-            const uint8_t *ie_ptr = frame->payload + fixedFieldsSize;
-            size_t ie_remaining = len - mgmt_hdr_size - fixedFieldsSize;
-
-            while(ie_remaining >= 2) {
-              const wifi_80211_ie *ie = (const wifi_80211_ie *) ie_ptr;
-              if(ie_remaining < (size_t)(2 + ie->length)) break;
-
-              if(ie->id == IE_COUNTRY && ie->length >= 3) {
-                countryCode[0] = (char) ie->data[0];
-                countryCode[1] = (char) ie->data[1];
+          if(bodyLength > fixedFieldsSize) {
+            // The local network's beacon is sent ten times a second and hardly ever changes - its
+            // elements are parsed again only when the rest of it has
+            if(subtype == BEACON && localBeaconSeen && checksumBeacon((uint8_t *) frame, frameLength, localBeaconTimOffset) == localBeaconChecksum) {
+              APPROXIMATE_STATS_COUNT(stats.beaconsUnchanged);
+            }
+            else {
+              elements.parse((uint8_t *) frame, mgmt_hdr_size + fixedFieldsSize, bodyLength - fixedFieldsSize, (1 << InfoElements::COUNTRY) | (1 << InfoElements::TIM));
+
+              uint8_t countryLength;
+              const uint8_t *country = elements.get(InfoElements::COUNTRY, countryLength);
+              if(country && countryLength >= 3) {
+                countryCode[0] = (char) country[0];
+                countryCode[1] = (char) country[1];
                 countryCode[2] = '\0';
-                countryEnvironment = (char) ie->data[2];
+                countryEnvironment = (char) country[2];
+
+                //the channels permitted here are the ones to scan
+                channelScheduler.setChannelsFromCountry(country, countryLength);
               }
 
-              ie_ptr += 2 + ie->length;
-              ie_remaining -= 2 + ie->length;
+              if(subtype == BEACON) {
+                // The TIM counts down to each DTIM beacon, and lists the stations with frames waiting, so is left out of the checksum
+                localBeaconTimOffset = max(elements.getOffset(InfoElements::TIM), 0);
+                localBeaconChecksum = checksumBeacon((uint8_t *) frame, frameLength, localBeaconTimOffset);
+                localBeaconSeen = true;
+              }
             }
           }
 
           success = true;
         }
+        else {
+          APPROXIMATE_STATS_COUNT(stats.framesOtherNetwork);
+        }
         break;
 
       case AUTHENTICATION:
-      case ASSOCIATION_REQ:
-      case REASSOCIATION_REQ:
-        // Auth/assoc requests from clients contain the client's MAC in addr2.
+        // Auth requests from clients contain the client's MAC in addr2.
         device->init(srcAddr, bssidAddr, channel, rssi, millis(), 0);
-        ArpTable::lookupIPAddress(device);
         success = true;
         break;
 
@@ -370,6 +542,39 @@ bool PacketSniffer::parseMgmtFrame(wifi_promiscuous_pkt_t *wifi_pkt, uint16_t le
   return(success);
 }
 
+size_t PacketSniffer::getFrameLength(uint16_t len, int type) {
+  // The length reported includes the 4-byte FCS
+  size_t frameLength = len > 4 ? len - 4 : 0;
+
+  #if defined(ESP8266)
+    // The ESP8266 passes no more than the first 112 bytes of a management frame
+    if(type == WIFI_PKT_MGMT) frameLength = min(frameLength, (size_t) 112);
+  #else
+    (void) type;
+  #endif
+
+  return(frameLength);
+}
+
+uint32_t PacketSniffer::checksumBeacon(const uint8_t *frame, size_t frameLength, size_t timOffset) {
+  // FNV-1a of the beacon's body, but not its timestamp - nor, if timOffset is not 0, the length and data of the
+  // TIM there. What comes before the TIM is included, so if it has moved the checksum differs anyway.
+  uint32_t checksum = 2166136261UL;
+
+  size_t skipFrom = frameLength, skipTo = frameLength;
+  if(timOffset >= 2 && timOffset <= frameLength && frame[timOffset - 2] == IE_TIM) {
+    skipFrom = timOffset - 1;
+    skipTo = timOffset + frame[timOffset - 1];
+  }
+
+  for(size_t n = sizeof(wifi_80211_mgmt_frame) + 8; n < frameLength; ++n) {
+    if(n == skipFrom) n = skipTo;
+    if(n < frameLength) checksum = (checksum ^ frame[n]) * 16777619UL;
+  }
+
+  return(checksum);
+}
+
 bool PacketSniffer::parseCtrlFrame(wifi_promiscuous_pkt_t *wifi_pkt, uint16_t len, int subtype, Device *device) {
   bool success = false;
 
@@ -396,7 +601,6 @@ bool PacketSniffer::parseCtrlFrame(wifi_promiscuous_pkt_t *wifi_pkt, uint16_t le
         if(deviceAddr.addr[3] == 0x0 && deviceAddr.addr[4] == 0x0 && deviceAddr.addr[5] == 0x0) return false;
 
         device->init(deviceAddr, emptyBssid, channel, rssi, millis(), 0);
-        ArpTable::lookupIPAddress(device);
         success = true;
         break;
       }
@@ -421,8 +625,9 @@ bool PacketSniffer::parseCtrlFrame(wifi_promiscuous_pkt_t *wifi_pkt, uint16_t le
 bool PacketSniffer::parseDataFrame(wifi_promiscuous_pkt_t *wifi_pkt, uint16_t payloadLengthBytes, Device *device) {
   bool success = false;
 
-  Packet *packet = new Packet();
-  if(wifi_pkt && device && packet) {
+  Packet framePacket;  //per-frame scratch, kept off the heap
+  Packet *packet = &framePacket;
+  if(wifi_pkt && device) {
     wifi_pkt_rx_ctrl_t *rx_ctrl = &(wifi_pkt -> rx_ctrl);
     packet -> rssi = rx_ctrl->rssi;
     packet -> channel = rx_ctrl->channel;
@@ -438,20 +643,34 @@ bool PacketSniffer::parseDataFrame(wifi_promiscuous_pkt_t *wifi_pkt, uint16_t pa
     if(ds == 1 && eth_addr_cmp(&(packet -> dst), &localBSSID)) {
       //packet sent by this device
       device -> init(packet -> src, localBSSID, packet -> channel, packet -> rssi, millis(), packet -> payloadLengthBytes * -1);
-      ArpTable::lookupIPAddress(device);
       success = true;
     }
     else if(ds == 2 && eth_addr_cmp(&(packet -> src), &localBSSID)) {
       //packet sent to this device - RSSI only informative for messages from device
       device -> init(packet -> dst, localBSSID, packet -> channel, packet -> rssi, millis(), packet -> payloadLengthBytes);
-      ArpTable::lookupIPAddress(device);
       success = true;
     }
     else {
       //not associated with this bssid - not on this network
+      APPROXIMATE_STATS_COUNT(stats.framesOtherNetwork);
+    }
+  }
+
+  return(success);
+}
+
+bool PacketSniffer::parseSequenceControl(wifi_promiscuous_pkt_t *wifi_pkt, uint16_t &sequenceControl, bool &retry) {
+  bool success = false;
+
+  if(wifi_pkt) {
+    //management and data frame headers are the same as far as the sequence control field
+    wifi_80211_data_frame *frame = (wifi_80211_data_frame *) getFrameStart(wifi_pkt);
+    if(frame -> fctl.type == WIFI_PKT_MGMT || frame -> fctl.type == WIFI_PKT_DATA) {
+      sequenceControl = (uint16_t) frame -> seqctl;
+      retry = frame -> fctl.retry;
+      success = true;
     }
   }
-  delete(packet);
 
   return(success);
 }
@@ -467,6 +686,9 @@ bool PacketSniffer::parseCSI(wifi_csi_info_t *info, Channel *channel) {
       //Filter this network:
       if(eth_addr_cmp(&thisBssid, &localBSSID)) {
         channel -> setBssid(thisBssid);
+        channel -> setChannel(info -> rx_ctrl.channel);
+        channel -> setRSSI(info -> rx_ctrl.rssi);
+        channel -> setTimestampUs(info -> rx_ctrl.timestamp);
         channel -> setBuffer(info->buf);
 
         success = true;
@@ -15,8 +15,12 @@
 #include "wifi_pkt.h"
 #include "Device.h"
 #include "Channel.h"
+#include "ChannelScheduler.h"
 #include "Packet.h"
 #include "ArpTable.h"
+#include "FrameQueue.h"
+#include "InfoElements.h"
+#include "Stats.h"
 
 class PacketSniffer {
   public:
@@ -32,6 +36,23 @@ class PacketSniffer {
 
     bool getChannelScan();
     void setChannelScan(bool channelScan);
+    static ChannelScheduler *getChannelScheduler();
+
+    // Frame classes passed to the packet event handler - bit (1 << type) for each wifi_promiscuous_pkt_type_t
+    static const uint8_t FRAME_MGMT = 0x1;
+    static const uint8_t FRAME_CTRL = 0x2;
+    static const uint8_t FRAME_DATA = 0x4;
+    static const uint8_t FRAME_MISC = 0x8;
+    static const uint8_t FRAME_ALL = 0xF;
+
+    // Set in the radio driver where it can be (ESP32), otherwise frames are rejected on entry to the callback;
+    // control frames are further selected by subtype - bit (1 << subtype)
+    void setFrameFilter(uint8_t frameMask, uint16_t ctrlSubtypeMask = 0xFFFF);
+    uint8_t getFrameFilter();
+    uint16_t getCtrlFrameFilter();
+    static inline bool isFrameWanted(int type, int subtype) {
+      return((frameMask & (1 << type)) && (type != WIFI_PKT_CTRL || (ctrlSubtypeMask & (1 << subtype))));
+    }
 
     typedef bool (*PacketEventHandler)(wifi_promiscuous_pkt_t *packet, uint16_t len, int type, int subtype);
     void setPacketEventHandler(PacketEventHandler packetEventHandler);
@@ -39,11 +60,36 @@ class PacketSniffer {
     typedef void (*ChannelEventHandler)(wifi_csi_info_t *data);
     void setChannelEventHandler(ChannelEventHandler channelEventHandler);
 
+    // Deferred mode - the radio callback only queues frames, loop() parses them
+    void setDeferred(bool deferred);
+    bool isDeferred();
+    uint32_t getDroppedFrameCount();
+    uint32_t getQueueHighWaterMark();
+
+    // Counters for the radio callback - see Stats.h
+    struct Stats {
+      uint32_t framesBySubtype[4][16] = {{0}};   //[wifi_promiscuous_pkt_type_t][subtype], passed to the packet event handler
+      uint32_t framesRejected = 0;               //by the frame filter, on entry to the callback - not counted on the ESP32, where the driver drops them
+      uint32_t framesOtherNetwork = 0;           //data frames, beacons and probe responses not of the local BSSID
+      uint32_t beaconsUnchanged = 0;             //the local network's, whose elements were not parsed again
+      LatencyHistogram callbackCycles;           //from entry to the callback until it returns, having parsed the frame or queued it
+    };
+    static void getStats(Stats &stats);
+    static void resetStats();
+
     // Low-level frame parsing
     static bool parseMgmtFrame(wifi_promiscuous_pkt_t *pkt, uint16_t len, int subtype, Device *device);
     static bool parseCtrlFrame(wifi_promiscuous_pkt_t *pkt, uint16_t len, int subtype, Device *device);
     static bool parseDataFrame(wifi_promiscuous_pkt_t *pkt, uint16_t payloadLengthBytes, Device *device);
     static bool parseCSI(wifi_csi_info_t *info, Channel *channel);
+    // The sequence control field of a management or data frame, and whether the frame is marked as a retransmission -
+    // false for a control frame, which has none
+    static bool parseSequenceControl(wifi_promiscuous_pkt_t *pkt, uint16_t &sequenceControl, bool &retry);
+
+    #if defined(APPROXIMATE_NATIVE)
+      // Host build only - deliver a captured frame as if the radio had received it
+      static void replay(wifi_promiscuous_pkt_t *packet, wifi_promiscuous_pkt_type_t type);
+    #endif
 
     // Local BSSID management
     static void setLocalBSSID(eth_addr &bssid);
@@ -63,26 +109,45 @@ class PacketSniffer {
     uint8_t currentChannel = -1;
     bool channelScan = false;
 
-    int channelSamplingIntervalMs = 1000;
-    int channelSamplingStartedAtMs = 0;
-    int highestChannel = 13; //US = 11, EU = 13, Japan = 14
+    static ChannelScheduler channelScheduler;
+
+    #if !defined(APPROXIMATE_NO_STATS)
+      static Stats stats;
+    #endif
+
+    static uint8_t frameMask;
+    static uint16_t ctrlSubtypeMask;
+    static void applyFrameFilter();
 
     static void rxCallback_8266(uint8_t *buf, uint16_t len);
     static void rxCallback_32(void* buf, wifi_promiscuous_pkt_type_t type);
-    static void rxCallback(wifi_promiscuous_pkt_t *packet, uint16_t len, wifi_promiscuous_pkt_type_t type, int subtype);
+    //capturedLength - the bytes of the frame, from getFrameStart(), that the driver passed
+    static void rxCallback(wifi_promiscuous_pkt_t *packet, uint16_t len, uint16_t capturedLength, wifi_promiscuous_pkt_type_t type, int subtype);
 
     static void csiCallback_32(void *ctx, wifi_csi_info_t *data);
 
     // Returns pointer to start of 802.11 MAC frame within the packet payload.
     // On ESP8266, AMPDU subframes have a 4-byte delimiter before the MAC header.
     static uint8_t* getFrameStart(wifi_promiscuous_pkt_t *pkt);
+    // The length of the 802.11 frame, less its FCS - and no more than the driver has passed.
+    static size_t getFrameLength(uint16_t len, int type);
 
     static PacketEventHandler packetEventHandler;
     static ChannelEventHandler channelEventHandler;
 
+    static bool deferred;
+    static FrameQueue *frameQueue;
+    void processFrameQueue();
+
     static eth_addr localBSSID;
     static char countryCode[3];
     static char countryEnvironment;
+
+    // The local network's last beacon, to tell whether the next has changed - see checksumBeacon()
+    static bool localBeaconSeen;
+    static uint32_t localBeaconChecksum;
+    static uint16_t localBeaconTimOffset;      // of the TIM's data, from the start of the frame - 0 if it had none
+    static uint32_t checksumBeacon(const uint8_t *frame, size_t frameLength, size_t timOffset);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,77 @@
+/*
+    RSSIEstimator.cpp
+    Approximate Library
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include "RSSIEstimator.h"
+
+//the Kalman filter's noise, in sixteenths of a dB squared
+static const int32_t KALMAN_PROCESS_VARIANCE = 1 * 16;
+static const int32_t KALMAN_MEASUREMENT_VARIANCE = 16 * 16;
+
+RSSIEstimator::RSSIEstimator() {
+  reset(RAW, 0);
+}
+
+void RSSIEstimator::reset(Type type, int priorRSSI) {
+  this -> type = type;
+  estimate = priorRSSI * 16;
+
+  if(type == MEDIAN) {
+    for(int n = 0; n < MEDIAN_SIZE; ++n) values[n] = priorRSSI;
+    next = 0;
+  }
+  else if(type == KALMAN) {
+    variance = KALMAN_MEASUREMENT_VARIANCE;
+  }
+}
+
+int RSSIEstimator::update(Type type, int rssi) {
+  if(type != this -> type) reset(type, rssi);
+
+  int32_t value = rssi * 16;
+
+  switch(type) {
+    case RAW:
+      estimate = value;
+      break;
+
+    case EWMA:
+      estimate += (value - estimate) / 4;
+      break;
+
+    case MEDIAN: {
+      values[next] = rssi;
+      next = (next + 1) % MEDIAN_SIZE;
+
+      //a sort of so few values is quicker than anything cleverer:
+      int8_t sorted[MEDIAN_SIZE];
+      for(int n = 0; n < MEDIAN_SIZE; ++n) {
+        int m = n;
+        for(; m > 0 && sorted[m - 1] > values[n]; --m) sorted[m] = sorted[m - 1];
+        sorted[m] = values[n];
+      }
+      estimate = sorted[MEDIAN_SIZE / 2] * 16;
+      break;
+    }
+
+    case KALMAN: {
+      int32_t p = variance + KALMAN_PROCESS_VARIANCE;
+      int32_t gain = (p << 8) / (p + KALMAN_MEASUREMENT_VARIANCE);    //in 256ths
+
+      estimate += ((value - estimate) * gain) / 256;
+      variance = (uint16_t) (((256 - gain) * p) / 256);
+      break;
+    }
+  }
+
+  return(get());
+}
+
+int RSSIEstimator::get() {
+  //rounded to the nearest dBm
+  return((estimate + (estimate < 0 ? -8 : 8)) / 16);
+}
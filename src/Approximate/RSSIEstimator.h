@@ -0,0 +1,56 @@
+/*
+    RSSIEstimator.h
+    Approximate Library
+    -
+    A smoothed estimate of a device's RSSI, from the noisy values of each of
+    its frames - small enough to be held in every device record and updated
+    in constant time with integer arithmetic. The kinds of estimate are:
+
+      RAW     the last value, unsmoothed
+      EWMA    an exponentially weighted moving average, each new value given
+              a weight of a quarter
+      MEDIAN  the median of the last 5 values - ignores isolated outliers
+      KALMAN  a one dimensional Kalman filter, assuming the true RSSI drifts
+              by about 1 dB between frames and each value is within 4 dB
+
+    The estimate starts from a prior value, typically the lower edge of the
+    proximate band, so that a single strong frame is not enough to arrive.
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#ifndef RSSIEstimator_h
+#define RSSIEstimator_h
+
+#include <Arduino.h>
+
+class RSSIEstimator {
+  public:
+    typedef enum {
+      RAW,
+      EWMA,
+      MEDIAN,
+      KALMAN
+    } Type;
+
+    static const int MEDIAN_SIZE = 5;
+
+  private:
+    uint8_t type = RAW;
+    uint8_t next = 0;                   //the oldest of the median's values
+    int16_t estimate = 0;               //in sixteenths of a dBm
+    union {
+      int8_t values[MEDIAN_SIZE];       //MEDIAN
+      uint16_t variance;                //KALMAN, in sixteenths of a dB squared
+    };
+
+  public:
+    RSSIEstimator();
+
+    void reset(Type type, int priorRSSI);
+    int update(Type type, int rssi);    //the new estimate - reset first if the type has changed
+    int get();
+};
+
+#endif
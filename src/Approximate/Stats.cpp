@@ -0,0 +1,59 @@
+/*
+    Stats.cpp
+    Approximate Library
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include "Stats.h"
+
+void LatencyHistogram::add(uint32_t cycles) {
+  int bucket = cycles ? min(32 - __builtin_clz(cycles), BUCKETS - 1) : 0;
+  Stats::increment(counts[bucket]);
+
+  if(cycles > maxCycles) maxCycles = cycles;
+}
+
+void LatencyHistogram::reset() {
+  for(int n = 0; n < BUCKETS; ++n) counts[n] = 0;
+  maxCycles = 0;
+}
+
+uint32_t LatencyHistogram::getCount() {
+  uint32_t count = 0;
+  for(int n = 0; n < BUCKETS; ++n) count += counts[n];
+
+  return(count);
+}
+
+uint32_t LatencyHistogram::getCount(int bucket) {
+  return((bucket >= 0 && bucket < BUCKETS) ? counts[bucket] : 0);
+}
+
+uint32_t LatencyHistogram::getPercentile(int percent) {
+  uint32_t result = 0;
+
+  uint32_t count = getCount();
+  if(count > 0) {
+    //the rank of the percentile, counting from 1
+    percent = min(max(percent, 0), 100);
+    uint32_t rank = max((uint32_t) (((uint64_t) count * percent + 99) / 100), (uint32_t) 1);
+
+    uint32_t seen = 0;
+    for(int n = 0; n < BUCKETS; ++n) {
+      seen += counts[n];
+      if(seen >= rank) {
+        //the last bucket is open-ended
+        result = (n == BUCKETS - 1) ? maxCycles : (uint32_t) ((1ULL << n) - 1);
+        break;
+      }
+    }
+  }
+
+  return(result);
+}
+
+uint32_t LatencyHistogram::getMax() {
+  return(maxCycles);
+}
@@ -0,0 +1,72 @@
+/*
+    Stats.h
+    Approximate Library
+    -
+    Counters and latency histograms for the stages of the packet pipeline,
+    read as a snapshot from PacketSniffer::getStats() and
+    Approximate::getStats(). Latencies are measured with the CPU's cycle
+    counter and kept as log2 histograms - a count per power of two - so that
+    recording one is a few instructions and the memory used is fixed. Each
+    counter has one writer: the radio callback, or loop() when parsing is
+    deferred. Defining APPROXIMATE_NO_STATS removes all of it, and the
+    snapshots are then always zero.
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#ifndef Stats_h
+#define Stats_h
+
+#include <Arduino.h>
+
+class LatencyHistogram {
+  public:
+    //bucket n counts the latencies of at least 2^(n-1) and less than 2^n cycles - bucket 0 those of none
+    static const int BUCKETS = 32;
+
+  private:
+    uint32_t counts[BUCKETS] = {0};
+    uint32_t maxCycles = 0;
+
+  public:
+    void add(uint32_t cycles);
+    void reset();
+
+    uint32_t getCount();
+    uint32_t getCount(int bucket);
+    uint32_t getPercentile(int percent);   //the upper bound of the bucket it falls in, in cycles
+    uint32_t getMax();
+};
+
+class Stats {
+  public:
+    static inline void increment(uint32_t &counter) {
+      #if defined(ESP8266)
+        //single core, and no atomic instructions - the one writer is not interrupted by another
+        ++counter;
+      #else
+        __atomic_fetch_add(&counter, 1, __ATOMIC_RELAXED);
+      #endif
+    }
+
+    static inline uint32_t cycles() {
+      return(ESP.getCycleCount());
+    }
+
+    static inline uint32_t cyclesToNs(uint32_t cycles) {
+      return((uint32_t) (((uint64_t) cycles * 1000) / ESP.getCpuFreqMHz()));
+    }
+};
+
+#if defined(APPROXIMATE_NO_STATS)
+  #define APPROXIMATE_STATS_COUNT(counter) do {} while(0)
+  #define APPROXIMATE_STATS_START(start) do {} while(0)
+  #define APPROXIMATE_STATS_LATENCY(histogram, start) do {} while(0)
+#else
+  #define APPROXIMATE_STATS_COUNT(counter) ::Stats::increment(counter)
+  #define APPROXIMATE_STATS_START(start) uint32_t start = ::Stats::cycles()
+  #define APPROXIMATE_STATS_LATENCY(histogram, start) (histogram).add(::Stats::cycles() - (start))
+#endif
+
+#endif
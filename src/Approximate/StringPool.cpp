@@ -0,0 +1,142 @@
+/*
+    StringPool.cpp
+    Approximate Library
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include "StringPool.h"
+
+StringPool::~StringPool() {
+  delete[] entries;
+  delete[] freeEntries;
+  delete[] index;
+}
+
+bool StringPool::init(int capacity) {
+  bool success = false;
+
+  if(!entries && capacity > 0 && capacity < EMPTY / 2) {
+    //the index is kept no more than half full
+    uint32_t indexSize = 2;
+    while(indexSize < (uint32_t) capacity * 2) indexSize <<= 1;
+
+    entries = new Entry[capacity];
+    freeEntries = new uint16_t[capacity];
+    index = new uint16_t[indexSize];
+    mask = indexSize - 1;
+    this -> capacity = capacity;
+    clear();
+
+    success = true;
+  }
+
+  return(success);
+}
+
+bool StringPool::isInitialised() {
+  return(entries != NULL);
+}
+
+uint32_t StringPool::hash(const char *text, uint8_t length) {
+  //FNV-1a
+  uint32_t h = 2166136261UL;
+  for(int n = 0; n < length; ++n) {
+    h ^= (uint8_t) text[n];
+    h *= 16777619UL;
+  }
+
+  return(h);
+}
+
+int StringPool::find(const char *text, uint8_t length) {
+  uint32_t i = hash(text, length) & mask;
+
+  while(index[i] != EMPTY) {
+    Entry &entry = entries[index[i]];
+    if(entry.length == length && memcmp(entry.text, text, length) == 0) break;
+    i = (i + 1) & mask;
+  }
+
+  return(i);
+}
+
+uint16_t StringPool::intern(const char *text) {
+  uint16_t handle = NONE;
+
+  if(entries && text) {
+    uint8_t length = strnlen(text, MAX_LENGTH);
+
+    if(length > 0) {
+      int i = find(text, length);
+
+      if(index[i] != EMPTY) {
+        ++entries[index[i]].references;
+        handle = index[i] + 1;
+      }
+      else if(freeCount > 0) {
+        uint16_t e = freeEntries[--freeCount];
+        Entry &entry = entries[e];
+        entry.references = 1;
+        entry.length = length;
+        memcpy(entry.text, text, length);
+        entry.text[length] = '\0';
+
+        index[i] = e;
+        handle = e + 1;
+      }
+    }
+  }
+
+  return(handle);
+}
+
+void StringPool::retain(uint16_t handle) {
+  if(handle != NONE && handle <= capacity) ++entries[handle - 1].references;
+}
+
+void StringPool::release(uint16_t handle) {
+  if(handle != NONE && handle <= capacity) {
+    uint16_t e = handle - 1;
+    Entry &entry = entries[e];
+
+    if(entry.references > 0 && --entry.references == 0) {
+      //backward-shift deletion from the index, as MacMap
+      uint32_t hole = find(entry.text, entry.length);
+      for(uint32_t j = (hole + 1) & mask; index[j] != EMPTY; j = (j + 1) & mask) {
+        Entry &later = entries[index[j]];
+        uint32_t home = hash(later.text, later.length) & mask;
+        if(((j - home) & mask) >= ((j - hole) & mask)) {
+          index[hole] = index[j];
+          hole = j;
+        }
+      }
+      index[hole] = EMPTY;
+
+      freeEntries[freeCount++] = e;
+    }
+  }
+}
+
+const char *StringPool::get(uint16_t handle) {
+  return((handle != NONE && handle <= capacity) ? entries[handle - 1].text : "");
+}
+
+void StringPool::clear() {
+  if(entries) {
+    for(uint32_t i = 0; i <= mask; ++i) index[i] = EMPTY;
+    for(int n = 0; n < capacity; ++n) entries[n].references = 0;
+
+    freeCount = capacity;
+    for(int n = 0; n < capacity; ++n) freeEntries[n] = capacity - 1 - n;
+  }
+}
+
+int StringPool::getCount() {
+  return(capacity - freeCount);
+}
+
+int StringPool::getCapacity() {
+  return(capacity);
+}
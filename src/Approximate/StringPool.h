@@ -0,0 +1,64 @@
+/*
+    StringPool.h
+    Approximate Library
+    -
+    A fixed number of short strings (such as SSIDs), each held once however
+    many records refer to it. A string is interned for a 16-bit handle - 0
+    is no string - and counted; it is freed when the last reference to it is
+    released. Strings are found by a hash of their text, in an open-addressing
+    index of handles, so interning one that is already held does not scan
+    the pool.
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#ifndef StringPool_h
+#define StringPool_h
+
+#include <Arduino.h>
+
+class StringPool {
+  public:
+    static const int MAX_LENGTH = 32;   //longer strings are cut short - an SSID is at most 32 bytes
+    static const uint16_t NONE = 0;
+
+  private:
+    typedef struct {
+      uint16_t references;              //0 when the entry is free
+      uint8_t length;
+      char text[MAX_LENGTH + 1];
+    } Entry;
+
+    static const uint16_t EMPTY = 0xFFFF;
+
+    Entry *entries = NULL;
+    uint16_t *freeEntries = NULL;       //stack of unused entry indices
+    int freeCount = 0;
+    int capacity = 0;
+
+    uint16_t *index = NULL;             //entry indices, by hash
+    uint16_t mask = 0;
+
+    static uint32_t hash(const char *text, uint8_t length);
+    int find(const char *text, uint8_t length);   //the index slot holding the string, or of the empty slot where it would go
+
+  public:
+    ~StringPool();
+
+    bool init(int capacity);
+    bool isInitialised();
+
+    //a handle to the string, counting one more reference to it - NONE for the empty string, or if the pool is full
+    uint16_t intern(const char *text);
+    void retain(uint16_t handle);
+    void release(uint16_t handle);
+
+    const char *get(uint16_t handle);   //"" for NONE
+    void clear();
+
+    int getCount();
+    int getCapacity();
+};
+
+#endif
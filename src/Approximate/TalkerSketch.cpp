@@ -0,0 +1,182 @@
+/*
+    TalkerSketch.cpp
+    Approximate Library
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include "TalkerSketch.h"
+
+#define TALKER_SKETCH_MASK (APPROXIMATE_TALKER_SKETCH_WIDTH - 1)
+
+//the cell of each row for a MAC address - two halves of one well-mixed hash, combined differently for each row
+static inline void cellsFor(eth_addr &macAddress, uint32_t cell[APPROXIMATE_TALKER_SKETCH_DEPTH]) {
+  uint64_t h = eth_addr_to_uint64(macAddress);
+  h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+  h ^= (h >> 31);
+
+  uint32_t h1 = (uint32_t) h;
+  uint32_t h2 = (uint32_t) (h >> 32) | 1;
+  for(int row = 0; row < APPROXIMATE_TALKER_SKETCH_DEPTH; ++row) {
+    cell[row] = row * APPROXIMATE_TALKER_SKETCH_WIDTH + ((h1 + row * h2) & TALKER_SKETCH_MASK);
+  }
+}
+
+TalkerSketch::~TalkerSketch() {
+  delete[] cells;
+}
+
+bool TalkerSketch::init() {
+  if(!cells) cells = new Cell[APPROXIMATE_TALKER_SKETCH_DEPTH * APPROXIMATE_TALKER_SKETCH_WIDTH];
+  clear();
+
+  return(cells != NULL);
+}
+
+bool TalkerSketch::isInitialised() {
+  return(cells != NULL);
+}
+
+void TalkerSketch::clear() {
+  if(cells) memset(cells, 0, sizeof(Cell) * APPROXIMATE_TALKER_SKETCH_DEPTH * APPROXIMATE_TALKER_SKETCH_WIDTH);
+  heapCount = 0;
+  totalBytes = 0;
+  totalFrames = 0;
+}
+
+void TalkerSketch::add(eth_addr &macAddress, int dataFlowBytes) {
+  if(cells) {
+    uint32_t cell[APPROXIMATE_TALKER_SKETCH_DEPTH];
+    cellsFor(macAddress, cell);
+
+    uint32_t uploadBytes = (dataFlowBytes < 0) ? -dataFlowBytes : 0;
+    uint32_t downloadBytes = (dataFlowBytes > 0) ? dataFlowBytes : 0;
+    totalBytes += uploadBytes + downloadBytes;
+    ++totalFrames;
+
+    //the counts so far are the least of the device's cells...
+    Talker talker;
+    getLeast(macAddress, cell, talker);
+    talker.uploadBytes += uploadBytes;
+    talker.downloadBytes += downloadBytes;
+    talker.frames += 1;
+
+    //...and no cell need be raised beyond the new counts
+    for(int row = 0; row < APPROXIMATE_TALKER_SKETCH_DEPTH; ++row) {
+      Cell &c = cells[cell[row]];
+      c.uploadBytes = max(c.uploadBytes, talker.uploadBytes);
+      c.downloadBytes = max(c.downloadBytes, talker.downloadBytes);
+      c.frames = max(c.frames, talker.frames);
+    }
+
+    //a device already in the heap has at least the bytes of its root - so most devices go no further than this
+    if(heapCount < APPROXIMATE_TOP_TALKERS || talker.getBytes() >= heap[0].getBytes()) {
+      int n = 0;
+      while(n < heapCount && memcmp(heap[n].macAddress.addr, macAddress.addr, 6) != 0) ++n;
+
+      if(n < heapCount) {
+        heap[n] = talker;
+        siftDown(n);
+      }
+      else if(heapCount < APPROXIMATE_TOP_TALKERS) {
+        heap[heapCount] = talker;
+        siftUp(heapCount++);
+      }
+      else if(talker.getBytes() > heap[0].getBytes()) {
+        heap[0] = talker;
+        siftDown(0);
+      }
+    }
+  }
+}
+
+void TalkerSketch::getLeast(eth_addr &macAddress, const uint32_t *cell, Talker &talker) {
+  talker = { macAddress, UINT32_MAX, UINT32_MAX, UINT32_MAX };
+  for(int row = 0; row < APPROXIMATE_TALKER_SKETCH_DEPTH; ++row) {
+    Cell &c = cells[cell[row]];
+    talker.uploadBytes = min(talker.uploadBytes, c.uploadBytes);
+    talker.downloadBytes = min(talker.downloadBytes, c.downloadBytes);
+    talker.frames = min(talker.frames, c.frames);
+  }
+}
+
+void TalkerSketch::siftUp(int n) {
+  while(n > 0) {
+    int parent = (n - 1) / 2;
+    if(heap[parent].getBytes() <= heap[n].getBytes()) break;
+
+    Talker t = heap[parent];
+    heap[parent] = heap[n];
+    heap[n] = t;
+    n = parent;
+  }
+}
+
+void TalkerSketch::siftDown(int n) {
+  while(true) {
+    int least = n;
+    int left = 2 * n + 1;
+    int right = left + 1;
+    if(left < heapCount && heap[left].getBytes() < heap[least].getBytes()) least = left;
+    if(right < heapCount && heap[right].getBytes() < heap[least].getBytes()) least = right;
+    if(least == n) break;
+
+    Talker t = heap[least];
+    heap[least] = heap[n];
+    heap[n] = t;
+    n = least;
+  }
+}
+
+int TalkerSketch::getTopTalkers(Talker *talkers, int maxCount) {
+  int count = min(maxCount, heapCount);
+
+  //the heap is small, so is simply sorted - with each count brought up to date, as other devices may have raised its cells since
+  Talker sorted[APPROXIMATE_TOP_TALKERS];
+  for(int n = 0; n < heapCount; ++n) getTalker(heap[n].macAddress, sorted[n]);
+  for(int n = 1; n < heapCount; ++n) {
+    Talker t = sorted[n];
+    int m = n;
+    while(m > 0 && sorted[m - 1].getBytes() < t.getBytes()) {
+      sorted[m] = sorted[m - 1];
+      --m;
+    }
+    sorted[m] = t;
+  }
+  for(int n = 0; n < count; ++n) talkers[n] = sorted[n];
+
+  return(count);
+}
+
+bool TalkerSketch::getTalker(eth_addr &macAddress, Talker &talker) {
+  bool success = false;
+
+  if(cells) {
+    uint32_t cell[APPROXIMATE_TALKER_SKETCH_DEPTH];
+    cellsFor(macAddress, cell);
+
+    getLeast(macAddress, cell, talker);
+    success = (talker.frames > 0);
+  }
+
+  return(success);
+}
+
+uint32_t TalkerSketch::getTotalBytes() {
+  return(totalBytes);
+}
+
+uint32_t TalkerSketch::getTotalFrames() {
+  return(totalFrames);
+}
+
+uint32_t TalkerSketch::getErrorBoundBytes() {
+  //e/width of all the bytes counted
+  return((uint32_t) (2.71828f * totalBytes / APPROXIMATE_TALKER_SKETCH_WIDTH));
+}
+
+size_t TalkerSketch::getSizeBytes() {
+  return(sizeof(Cell) * APPROXIMATE_TALKER_SKETCH_DEPTH * APPROXIMATE_TALKER_SKETCH_WIDTH + sizeof(Talker) * APPROXIMATE_TOP_TALKERS);
+}
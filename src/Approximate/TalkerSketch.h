@@ -0,0 +1,97 @@
+/*
+    TalkerSketch.h
+    Approximate Library
+    -
+    The devices sending and receiving the most data, found in fixed memory
+    however many there are. A Count-Min sketch counts the bytes and frames of
+    every device: each of APPROXIMATE_TALKER_SKETCH_DEPTH rows hashes the MAC
+    address to one of APPROXIMATE_TALKER_SKETCH_WIDTH cells, and a device's
+    count is the least of its cells - never less than the truth, and more only
+    where other devices share all of its cells. Cells are raised no further
+    than that least count needs (a conservative update), which keeps the
+    overestimate small. Alongside, a min-heap keeps the APPROXIMATE_TOP_TALKERS
+    devices with the most bytes so far: a device replaces the least of them
+    once its count passes it.
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#ifndef TalkerSketch_h
+#define TalkerSketch_h
+
+#include <Arduino.h>
+#include "eth_addr.h"
+
+#ifndef APPROXIMATE_TALKER_SKETCH_DEPTH
+  #define APPROXIMATE_TALKER_SKETCH_DEPTH 4
+#endif
+
+#ifndef APPROXIMATE_TALKER_SKETCH_WIDTH
+  #if defined(ESP8266)
+    #define APPROXIMATE_TALKER_SKETCH_WIDTH 128   //must be a power of two - fewer, and the devices that share cells become many
+  #else
+    #define APPROXIMATE_TALKER_SKETCH_WIDTH 256
+  #endif
+#endif
+
+#ifndef APPROXIMATE_TOP_TALKERS
+  #if defined(ESP8266)
+    #define APPROXIMATE_TOP_TALKERS 8
+  #else
+    #define APPROXIMATE_TOP_TALKERS 16
+  #endif
+#endif
+
+class TalkerSketch {
+  public:
+    struct Talker {
+      eth_addr macAddress;
+      uint32_t uploadBytes;
+      uint32_t downloadBytes;
+      uint32_t frames;
+
+      uint32_t getBytes() { return(uploadBytes + downloadBytes); }
+    };
+
+  private:
+    struct Cell {
+      uint32_t uploadBytes;
+      uint32_t downloadBytes;
+      uint32_t frames;
+    };
+
+    Cell *cells = NULL;                         //APPROXIMATE_TALKER_SKETCH_WIDTH for each row in turn
+    Talker heap[APPROXIMATE_TOP_TALKERS];       //the least bytes at the root
+    int heapCount = 0;
+    uint32_t totalBytes = 0;
+    uint32_t totalFrames = 0;
+
+    void getLeast(eth_addr &macAddress, const uint32_t *cell, Talker &talker);    //of the cells of each row
+    void siftUp(int n);
+    void siftDown(int n);
+
+  public:
+    ~TalkerSketch();
+
+    //allocating only the first time; always empties the sketch
+    bool init();
+    bool isInitialised();
+    void clear();
+
+    //dataFlowBytes as Device - uploading is negative, downloading positive
+    void add(eth_addr &macAddress, int dataFlowBytes);
+
+    //the devices with the most bytes, the most first - no more than maxCount, nor APPROXIMATE_TOP_TALKERS
+    int getTopTalkers(Talker *talkers, int maxCount);
+    bool getTalker(eth_addr &macAddress, Talker &talker);    //the counts of any device, which may be over
+
+    uint32_t getTotalBytes();
+    uint32_t getTotalFrames();
+    //how far over a count may be: at most this, on all but 1 in e^APPROXIMATE_TALKER_SKETCH_DEPTH (2%) of devices
+    uint32_t getErrorBoundBytes();
+
+    static size_t getSizeBytes();
+};
+
+#endif
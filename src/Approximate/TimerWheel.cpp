@@ -0,0 +1,112 @@
+/*
+    TimerWheel.cpp
+    Approximate Library
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include "TimerWheel.h"
+
+#define TIMER_WHEEL_MASK (APPROXIMATE_TIMER_WHEEL_BUCKETS - 1)
+#define TIMER_WHEEL_TICK_MASK (0xFFFFFFFFUL >> APPROXIMATE_TIMER_WHEEL_TICK_SHIFT)
+
+//ticks are millis() >> APPROXIMATE_TIMER_WHEEL_TICK_SHIFT, so wrap with it at fewer than 32 bits - compared modulo that
+static inline int32_t tickDifference(uint32_t tick, uint32_t fromTick) {
+  return((int32_t) ((tick - fromTick) << APPROXIMATE_TIMER_WHEEL_TICK_SHIFT) >> APPROXIMATE_TIMER_WHEEL_TICK_SHIFT);
+}
+
+TimerWheel::~TimerWheel() {
+  delete[] next;
+  delete[] prev;
+  delete[] bucketOf;
+  delete[] deadlineMs;
+}
+
+bool TimerWheel::init(int capacity, uint32_t nowMs) {
+  bool success = false;
+
+  if(!next && capacity > 0 && capacity < NIL) {
+    next = new uint16_t[capacity];
+    prev = new uint16_t[capacity];
+    bucketOf = new uint16_t[capacity];
+    deadlineMs = new uint32_t[capacity];
+    this -> capacity = capacity;
+
+    for(int n = 0; n < APPROXIMATE_TIMER_WHEEL_BUCKETS; ++n) buckets[n] = NIL;
+    for(int n = 0; n < capacity; ++n) bucketOf[n] = NIL;
+
+    cursorTick = nowMs >> APPROXIMATE_TIMER_WHEEL_TICK_SHIFT;
+    success = true;
+  }
+
+  return(success);
+}
+
+void TimerWheel::schedule(uint16_t id, uint32_t deadlineMs) {
+  if(id < capacity) {
+    unlink(id);
+
+    //a deadline already passed goes in the bucket at the cursor, so that it is found next time
+    uint32_t tick = deadlineMs >> APPROXIMATE_TIMER_WHEEL_TICK_SHIFT;
+    if(tickDifference(tick, cursorTick) < 0) tick = cursorTick;
+    uint16_t bucket = tick & TIMER_WHEEL_MASK;
+
+    this -> deadlineMs[id] = deadlineMs;
+    bucketOf[id] = bucket;
+    prev[id] = NIL;
+    next[id] = buckets[bucket];
+    if(next[id] != NIL) prev[next[id]] = id;
+    buckets[bucket] = id;
+  }
+}
+
+void TimerWheel::cancel(uint16_t id) {
+  if(id < capacity) unlink(id);
+}
+
+bool TimerWheel::isScheduled(uint16_t id) {
+  return(id < capacity && bucketOf[id] != NIL);
+}
+
+uint32_t TimerWheel::getDeadlineMs(uint16_t id) {
+  return(id < capacity ? deadlineMs[id] : 0);
+}
+
+void TimerWheel::unlink(uint16_t id) {
+  uint16_t bucket = bucketOf[id];
+
+  if(bucket != NIL) {
+    if(prev[id] != NIL) next[prev[id]] = next[id];
+    else buckets[bucket] = next[id];
+
+    if(next[id] != NIL) prev[next[id]] = prev[id];
+
+    bucketOf[id] = NIL;
+  }
+}
+
+int TimerWheel::nextExpired(uint32_t nowMs) {
+  int expired = -1;
+
+  if(next) {
+    uint32_t nowTick = nowMs >> APPROXIMATE_TIMER_WHEEL_TICK_SHIFT;
+
+    //after a long gap one full turn of the wheel visits every bucket:
+    int32_t behind = tickDifference(nowTick, cursorTick);
+    if(behind < 0) cursorTick = nowTick;
+    else if(behind > APPROXIMATE_TIMER_WHEEL_BUCKETS) cursorTick = (nowTick - APPROXIMATE_TIMER_WHEEL_BUCKETS) & TIMER_WHEEL_TICK_MASK;
+
+    while(expired < 0) {
+      for(uint16_t id = buckets[cursorTick & TIMER_WHEEL_MASK]; id != NIL && expired < 0; id = next[id]) {
+        if(isBefore(deadlineMs[id], nowMs)) expired = id;
+      }
+
+      if(expired >= 0) unlink(expired);
+      else if(cursorTick != nowTick) cursorTick = (cursorTick + 1) & TIMER_WHEEL_TICK_MASK;
+      else break;
+    }
+  }
+
+  return(expired);
+}
@@ -0,0 +1,63 @@
+/*
+    TimerWheel.h
+    Approximate Library
+    -
+    A hashed timing wheel of deadlines for up to a fixed number of ids (such as
+    slots in a DeviceTable). Each id sits in a doubly linked list at the bucket
+    for its deadline, so that scheduling and cancelling are O(1) and finding
+    what has expired touches only the buckets that time has passed through.
+    Deadlines further away than one turn of the wheel simply stay in their
+    bucket until a later turn. Times are compared by their signed difference,
+    so the wheel keeps working when millis() wraps after 49 days.
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#ifndef TimerWheel_h
+#define TimerWheel_h
+
+#include <Arduino.h>
+
+#ifndef APPROXIMATE_TIMER_WHEEL_BUCKETS
+  #define APPROXIMATE_TIMER_WHEEL_BUCKETS 512     //must be a power of two
+#endif
+
+#ifndef APPROXIMATE_TIMER_WHEEL_TICK_SHIFT
+  #define APPROXIMATE_TIMER_WHEEL_TICK_SHIFT 7    //each bucket spans 2^7 = 128ms
+#endif
+
+class TimerWheel {
+  private:
+    static const uint16_t NIL = 0xFFFF;
+
+    uint16_t buckets[APPROXIMATE_TIMER_WHEEL_BUCKETS];
+    uint16_t *next = NULL;
+    uint16_t *prev = NULL;
+    uint16_t *bucketOf = NULL;    //NIL when the id is not scheduled
+    uint32_t *deadlineMs = NULL;
+    int capacity = 0;
+
+    uint32_t cursorTick = 0;      //the earliest bucket that may still hold an expired id
+
+    void unlink(uint16_t id);
+
+  public:
+    ~TimerWheel();
+
+    bool init(int capacity, uint32_t nowMs);
+
+    void schedule(uint16_t id, uint32_t deadlineMs);    //re-arms an id that is already scheduled
+    void cancel(uint16_t id);
+    bool isScheduled(uint16_t id);
+    uint32_t getDeadlineMs(uint16_t id);                //of a scheduled id
+
+    //an id whose deadline has passed (is before nowMs), which is no longer scheduled - or -1 if there are none
+    int nextExpired(uint32_t nowMs);
+
+    static inline bool isBefore(uint32_t aMs, uint32_t bMs) {
+      return((int32_t) (bMs - aMs) > 0);
+    }
+};
+
+#endif
@@ -0,0 +1,85 @@
+/*
+    TrafficSummary.cpp
+    Approximate Library
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#include "TrafficSummary.h"
+
+void TrafficSummary::reset() {
+  *this = TrafficSummary();
+}
+
+void TrafficSummary::add(int dataFlowBytes, int rssi, uint32_t atMs, uint8_t handlers) {
+  if(getFrames() == 0) firstFrameAtMs = atMs;
+  lastFrameAtMs = atMs;
+  this -> handlers |= handlers;
+
+  if(dataFlowBytes < 0) {
+    uploadBytes += -dataFlowBytes;
+
+    rssi = min(max(rssi, -128), 127);
+    if(uploadFrames == 0 || rssi < rssiMin) rssiMin = rssi;
+    if(uploadFrames == 0 || rssi > rssiMax) rssiMax = rssi;
+    rssiSum += rssi;
+    ++uploadFrames;
+  }
+  else {
+    downloadBytes += dataFlowBytes;
+    ++downloadFrames;
+  }
+}
+
+uint8_t TrafficSummary::getHandlers() {
+  return(handlers);
+}
+
+uint32_t TrafficSummary::getFirstFrameAtMs() {
+  return(firstFrameAtMs);
+}
+
+uint32_t TrafficSummary::getLastFrameAtMs() {
+  return(lastFrameAtMs);
+}
+
+uint32_t TrafficSummary::getUploadBytes() {
+  return(uploadBytes);
+}
+
+uint32_t TrafficSummary::getDownloadBytes() {
+  return(downloadBytes);
+}
+
+uint32_t TrafficSummary::getUploadFrames() {
+  return(uploadFrames);
+}
+
+uint32_t TrafficSummary::getDownloadFrames() {
+  return(downloadFrames);
+}
+
+uint32_t TrafficSummary::getFrames() {
+  return(uploadFrames + downloadFrames);
+}
+
+int TrafficSummary::getRSSIMin() {
+  return(uploadFrames ? rssiMin : 0);
+}
+
+int TrafficSummary::getRSSIMax() {
+  return(uploadFrames ? rssiMax : 0);
+}
+
+int TrafficSummary::getRSSIMean() {
+  int result = 0;
+
+  if(uploadFrames) {
+    //rounded to the nearest, away from zero
+    int32_t n = (int32_t) uploadFrames;
+    result = (rssiSum < 0) ? (rssiSum - n / 2) / n : (rssiSum + n / 2) / n;
+  }
+
+  return(result);
+}
@@ -0,0 +1,53 @@
+/*
+    TrafficSummary.h
+    Approximate Library
+    -
+    The data frames of one device over a window of time, accumulated rather
+    than reported one at a time: bytes and frames in each direction, and the
+    least, greatest and mean RSSI. Only frames the device sent contribute to
+    the RSSI - the RSSI of a frame sent to it is the access point's.
+    -
+    David Chatting - github.com/davidchatting/Approximate
+    MIT License - Copyright (c) 2026
+*/
+
+#ifndef TrafficSummary_h
+#define TrafficSummary_h
+
+#include <Arduino.h>
+
+class TrafficSummary {
+  private:
+    uint32_t firstFrameAtMs = 0;
+    uint32_t lastFrameAtMs = 0;
+    uint32_t uploadBytes = 0;
+    uint32_t downloadBytes = 0;
+    uint32_t uploadFrames = 0;
+    uint32_t downloadFrames = 0;
+    int32_t rssiSum = 0;          //over the upload frames
+    int8_t rssiMin = 0;
+    int8_t rssiMax = 0;
+    uint8_t handlers = 0;         //who the summary is for - a mask chosen by the caller
+
+  public:
+    void reset();
+    //dataFlowBytes as Device - uploading is negative, downloading positive
+    void add(int dataFlowBytes, int rssi, uint32_t atMs, uint8_t handlers = 0);
+    uint8_t getHandlers();
+
+    uint32_t getFirstFrameAtMs();
+    uint32_t getLastFrameAtMs();
+
+    uint32_t getUploadBytes();
+    uint32_t getDownloadBytes();
+    uint32_t getUploadFrames();
+    uint32_t getDownloadFrames();
+    uint32_t getFrames();
+
+    //APPROXIMATE_UNKNOWN_RSSI (0) if the device sent no frames
+    int getRSSIMin();
+    int getRSSIMax();
+    int getRSSIMean();
+};
+
+#endif
@@ -38,56 +38,99 @@ bool oui_to_eth_addr(int oui, eth_addr &out) {
   return(success);
 }
 
-bool String_to_eth_addr(String &in, eth_addr &out) {
-  bool success = c_str_to_eth_addr(in.c_str(), out);
-
-  return(success);
+//Upper case, as printed by the network tools of most systems
+static const char hexDigits[] = "0123456789ABCDEF";
+
+//The value of each ASCII hex digit, in either case - and 0x10 for anything else
+static const uint8_t hexValues[128] = {
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,   //0-9
+  0x10, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,   //A-F
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,   //a-f
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+};
+
+static inline uint8_t hexValue(char c) {
+  //bytes above 0x7F also have bit 4 set once shifted down, so are never valid
+  uint8_t u = (uint8_t) c;
+  return(hexValues[u & 0x7F] | ((u >> 3) & 0x10));
 }
 
-bool c_str_to_eth_addr(const char *in, eth_addr &out) {
+//Parses ##:##:##:##:##:##, ##-##-##-##-##-## or ############, in either case.
+//Nothing is written to out unless the whole of in is valid.
+static bool parseMacAddress(const char *in, uint8_t *out) {
   bool success = false;
 
-  //clear:
-  for(int n=0; n<6; ++n) out.addr[n] = 0;
-
-  //basic format test ##:##:##:##:##:##
-  if(strlen(in) == 17) {
-    int a, b, c, d, e, f;
-    sscanf(in, "%x:%x:%x:%x:%x:%x", &a, &b, &c, &d, &e, &f);
+  if(in) {
+    size_t length = strnlen(in, 18);
+    int stride = 0;
+    uint8_t invalid = 0;
+
+    if(length == 17) {
+      //the same separator throughout
+      char separator = in[2];
+      if(separator == ':' || separator == '-') {
+        stride = 3;
+        for(int n = 5; n < 17; n += 3) invalid |= (in[n] != separator);
+      }
+    }
+    else if(length == 12) {
+      stride = 2;
+    }
+
+    if(stride && !invalid) {
+      uint8_t octets[6];
+      for(int n = 0; n < 6; ++n) {
+        uint8_t hi = hexValue(in[n * stride]);
+        uint8_t lo = hexValue(in[n * stride + 1]);
+        invalid |= hi | lo;
+        octets[n] = (hi << 4) | (lo & 0x0F);
+      }
+
+      if(!(invalid & 0x10)) {
+        memcpy(out, octets, 6);
+        success = true;
+      }
+    }
+  }
 
-    out.addr[0] = a;
-    out.addr[1] = b;
-    out.addr[2] = c;
-    out.addr[3] = d;
-    out.addr[4] = e;
-    out.addr[5] = f;
+  return(success);
+}
 
-    success = true;
+//Writes ##:##:##:##:##:## and its terminator - 18 chars
+static void formatMacAddress(const uint8_t *in, char *out) {
+  for(int n = 0; n < 6; ++n) {
+    out[0] = hexDigits[in[n] >> 4];
+    out[1] = hexDigits[in[n] & 0x0F];
+    out[2] = ':';
+    out += 3;
   }
+  out[-1] = '\0';
+}
+
+bool String_to_eth_addr(String &in, eth_addr &out) {
+  bool success = c_str_to_eth_addr(in.c_str(), out);
 
   return(success);
 }
 
-bool c_str_to_MacAddr(const char *in, MacAddr &out) {
-  bool success = false;
+bool c_str_to_eth_addr(const char *in, eth_addr &out) {
+  bool success = parseMacAddress(in, out.addr);
 
-  //clear:
-  for(int n=0; n<6; ++n) out.mac[n] = 0;
+  //cleared if it could not be parsed
+  if(!success) memset(out.addr, 0, 6);
 
-  //basic format test ##:##:##:##:##:##
-  if(strlen(in) == 17) {
-    int a, b, c, d, e, f;
-    sscanf(in, "%x:%x:%x:%x:%x:%x", &a, &b, &c, &d, &e, &f);
+  return(success);
+}
 
-    out.mac[0] = a;
-    out.mac[1] = b;
-    out.mac[2] = c;
-    out.mac[3] = d;
-    out.mac[4] = e;
-    out.mac[5] = f;
+bool c_str_to_MacAddr(const char *in, MacAddr &out) {
+  bool success = parseMacAddress(in, out.mac);
 
-    success = true;
-  }
+  //cleared if it could not be parsed
+  if(!success) memset(out.mac, 0, 6);
 
   return(success);
 }
@@ -96,8 +139,8 @@ bool eth_addr_to_String(eth_addr &in, String &out) {
   bool success = true;
 
   char macAddressAsCharArray[18];
-  eth_addr_to_c_str(in, macAddressAsCharArray);
-  out = String(macAddressAsCharArray);
+  formatMacAddress(in.addr, macAddressAsCharArray);
+  out = macAddressAsCharArray;
 
   return(success);
 }
@@ -105,7 +148,7 @@ bool eth_addr_to_String(eth_addr &in, String &out) {
 bool eth_addr_to_c_str(eth_addr &in, char *out) {
   bool success = true;
 
-  sprintf(out, "%02X:%02X:%02X:%02X:%02X:%02X\0", in.addr[0], in.addr[1], in.addr[2], in.addr[3], in.addr[4], in.addr[5]);
+  formatMacAddress(in.addr, out);
 
   return(success);
 }
@@ -113,7 +156,7 @@ bool eth_addr_to_c_str(eth_addr &in, char *out) {
 bool MacAddr_to_c_str(MacAddr *in, char *out) {
   bool success = true;
 
-  sprintf(out, "%02X:%02X:%02X:%02X:%02X:%02X\0", in->mac[0], in->mac[1], in->mac[2], in->mac[3], in->mac[4], in->mac[5]);
+  formatMacAddress(in -> mac, out);
 
   return(success);
 }
@@ -13,7 +13,7 @@
 #if defined(ESP8266)
     #include "netif/etharp.h"
 
-#elif defined(ESP32)
+#elif defined(ESP32) || defined(APPROXIMATE_NATIVE)
     #include "lwip/etharp.h"
     
 #endif
@@ -49,4 +49,10 @@ bool MacAddr_to_c_str(MacAddr *in, char *out);
 bool MacAddr_to_oui(MacAddr *in, int &out);
 bool MacAddr_to_MacAddr(MacAddr *in, MacAddr &out);
 
+//the 48-bit address as an integer key, first octet most significant
+inline uint64_t eth_addr_to_uint64(const eth_addr &in) {
+  return(((uint64_t) in.addr[0] << 40) | ((uint64_t) in.addr[1] << 32) | ((uint64_t) in.addr[2] << 24) |
+         ((uint64_t) in.addr[3] << 16) | ((uint64_t) in.addr[4] << 8) | (uint64_t) in.addr[5]);
+}
+
 #endif
\ No newline at end of file
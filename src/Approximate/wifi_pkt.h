@@ -76,6 +76,60 @@
   #include "esp_event.h"
   #include "esp_wifi_types.h"
 
+#elif defined(APPROXIMATE_NATIVE)
+  // Host build (see extras/native) - mirrors the ESP32 promiscuous-mode types
+  #include <WiFi.h>
+
+  typedef enum {
+    WIFI_PKT_MGMT,
+    WIFI_PKT_CTRL,
+    WIFI_PKT_DATA,
+    WIFI_PKT_MISC
+  } wifi_promiscuous_pkt_type_t;
+
+  typedef struct {
+      signed rssi: 8;             // signal intensity of packet
+      unsigned rate: 5;
+      unsigned: 1;
+      unsigned sig_mode: 2;       // 0: non-HT(11bg) packet; 1: HT(11n) packet; 3: VHT(11ac) packet
+      unsigned: 16;
+      unsigned mcs: 7;
+      unsigned cwb: 1;
+      unsigned: 16;
+      unsigned smoothing: 1;
+      unsigned not_sounding: 1;
+      unsigned: 1;
+      unsigned aggregation: 1;
+      unsigned stbc: 2;
+      unsigned fec_coding: 1;
+      unsigned sgi: 1;
+      signed noise_floor: 8;
+      unsigned ampdu_cnt: 8;
+      unsigned channel: 4;        // primary channel on which this packet is received
+      unsigned secondary_channel: 4;
+      unsigned: 8;
+      unsigned timestamp: 32;     // local time when this packet is received, in microseconds
+      unsigned: 32;
+      unsigned: 31;
+      unsigned ant: 1;
+      unsigned sig_len: 12;       // length of packet including Frame Check Sequence (FCS)
+      unsigned: 12;
+      unsigned rx_state: 8;
+  } wifi_pkt_rx_ctrl_t;
+
+  typedef struct {
+      wifi_pkt_rx_ctrl_t rx_ctrl;
+      uint8_t payload[0];         // ieee80211 payload
+  } wifi_promiscuous_pkt_t;
+
+  typedef struct {
+      wifi_pkt_rx_ctrl_t rx_ctrl;
+      uint8_t mac[6];
+      bool first_word_invalid;
+      int8_t *buf;
+      uint16_t len;
+  } wifi_csi_info_t;
+
 #endif
 
 // ---- IEEE 802.11 Management Frame Subtypes (Type 0) ----
@@ -217,13 +271,17 @@ typedef struct {
 } __attribute__((packed)) wifi_80211_ie;
 
 // Common IE IDs
-#define IE_SSID             0
-#define IE_SUPPORTED_RATES  1
-#define IE_DS_PARAM_SET     3
-#define IE_TIM              5
-#define IE_COUNTRY          7
-#define IE_RSN              48
-#define IE_VENDOR_SPECIFIC  221
+#define IE_SSID                 0
+#define IE_SUPPORTED_RATES      1
+#define IE_DS_PARAM_SET         3
+#define IE_TIM                  5
+#define IE_COUNTRY              7
+#define IE_HT_CAPABILITIES      45
+#define IE_RSN                  48
+#define IE_EXT_SUPPORTED_RATES  50
+#define IE_EXT_CAPABILITIES     127
+#define IE_VHT_CAPABILITIES     191
+#define IE_VENDOR_SPECIFIC      221
 
 // Country IE environment field values
 #define IE_COUNTRY_ENVIRONMENT_INDOOR  'I'